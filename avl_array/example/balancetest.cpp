@@ -0,0 +1,165 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+    AVL Array balancing policies test
+
+    This program compares the three balancing policies that can
+    be passed to avl_array as its last template parameter:
+
+      - avl_balance     (default) classic AVL trees
+      - wavl_balance    weak AVL (rank-balanced) trees
+      - weight_balance  weight-balanced trees
+
+    Every policy is run on the same three traces of edits at
+    random positions:
+
+      - Insert-heavy: 90% inserts, 10% erases, growing the
+        container from empty
+      - Erase-heavy: fill the container, then 90% erases, 10%
+        inserts until it is nearly empty
+      - Mixed: 50% inserts, 50% erases on a container of
+        stable size, with a read at every step
+
+    Random access by position costs the same with every policy
+    (all of them keep the trees logarithmic), so the differences
+    come from the rebalancing work done on every edit. The final
+    element is shown as a proof that all containers execute the
+    same operations.
+*/
+
+#include <iostream>
+#include <ctime>
+#include <cstdlib>
+
+#include <avl_array.hpp>
+
+using namespace std;
+using namespace mkr;
+
+// CONFIGURATION --------------------------------------------------
+
+        // Number of edits per trace
+
+const unsigned trace_size = 2000000U;
+
+// HELPER FUNCTIONS -----------------------------------------------
+
+unsigned random (unsigned max) // Return a random number
+{                              // in the interval [0,max)
+  unsigned n;
+
+  n = (unsigned)
+      ( max *
+        ( (double)rand() / RAND_MAX ) );
+
+  return n>=max ? max-1 : n;
+}
+
+double seconds (clock_t start)     // Elapsed time since start
+{
+  return (double)(clock()-start) / CLOCKS_PER_SEC;
+}
+
+// TESTING ALGORITHM ----------------------------------------------
+
+template<class C>
+unsigned edit (C & container,      // Perform n edits at random
+               unsigned n,         // positions; every one is an
+               unsigned percent)   // insert with a probability
+{                                  // of percent/100
+  unsigned i, result;
+
+  result = 0;
+
+  for (i=0; i<n; i++)
+    if (container.empty() ||
+        random (100) < percent)
+      container.insert (container.begin() +
+                        random (container.size()+1),
+                        rand());
+    else
+    {
+      container.erase (container.begin() +
+                       random (container.size()));
+
+      if (!container.empty())
+        result += container[random (container.size())];
+    }
+
+  return container.empty() ? result : result + container.front();
+}
+
+template<class C>
+void test (C unused,               // The unused parameter
+           const char * name)      // enforces C
+{
+  clock_t start;
+  unsigned result;
+
+  cout << endl << "Testing: " << name << endl   // Title and
+       << "Trace\t\tTime\tFinal element" << endl; // table header
+
+  {                                          // Insert-heavy
+    C container;
+
+    start = clock ();
+    result = edit (container, trace_size, 90);
+    cout << "insert-heavy\t" << seconds (start)
+         << '\t' << result << endl;
+  }
+
+  {                                          // Erase-heavy
+    C container;
+
+    container.resize (trace_size, 0U);
+    start = clock ();
+    result = edit (container, trace_size*5/4, 10);
+    cout << "erase-heavy\t" << seconds (start)
+         << '\t' << result << endl;
+  }
+
+  {                                          // Mixed
+    C container;
+
+    container.resize (trace_size/4, 0U);
+    start = clock ();
+    result = edit (container, trace_size, 50);
+    cout << "mixed\t\t" << seconds (start)
+         << '\t' << result << endl;
+  }
+}
+
+// PROGRAM BODY ---------------------------------------------------
+
+typedef allocator<unsigned> alloc;
+
+int main ()
+{
+  unsigned seed;
+                                           // Make a random seed
+  seed = (unsigned) time (NULL);           // with the current time
+  cout << "Random seed: " << seed << endl;
+
+  srand (seed);
+  test (avl_array<unsigned,alloc,false,size_t,
+                  false,size_t,avl_balance>(),
+        "avl_balance");
+                                           // Test every policy
+  srand (seed);                            // with the same random
+  test (avl_array<unsigned,alloc,false,size_t,  // sequence
+                  false,size_t,wavl_balance>(),
+        "wavl_balance");
+
+  srand (seed);
+  test (avl_array<unsigned,alloc,false,size_t,
+                  false,size_t,weight_balance>(),
+        "weight_balance");
+
+  return 0;
+}
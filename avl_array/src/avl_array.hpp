@@ -17,7 +17,7 @@
   Free Software Project hosted at:
   http://avl-array.sourceforge.net
 
-  The source code is organized in 27 different header files, of
+  The source code is organized in 48 different header files, of
   which this is the main one. All them have been profusely
   commented. The #include sections at the beginnig and the end of
   this file might serve as an index to the different files.
@@ -36,11 +36,28 @@
 //////////////////////////////////////////////////////////////////
 
 #include <iterator>
+#include <algorithm>
 #include <utility>
 #include <memory>
 #include <functional>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <limits>
 #include <cassert>
 
+#if __cplusplus >= 201103L || \
+    (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+#define AA_CXX11             // (for internal use only)
+#include <type_traits>
+#endif
+
+#ifdef AA_USE_THREADS
+#include <thread>
+#include <atomic>
+#include <exception>
+#endif
+
 //////////////////////////////////////////////////////////////////
 
 #ifdef AA_DEREF_NULL_ON_ASSERTION_FAILURE
@@ -71,18 +88,48 @@
 #include "detail/forward_decl.hpp"      // Forward declarations
                                         // (for internal use only)
 
+#include "detail/alloc_traits.hpp"      // Allocator types and
+                                        // propagation rules
+                                        // (for internal use only)
+
 #include "detail/data_provider.hpp"     // Helper functors
                                         // (for internal use only)
 
+#include "detail/chunk_worker.hpp"      // Parallel traversal
+                                        // functors
+                                        // (for internal use only)
+
 #include "detail/exception.hpp"         // Exceptions
 
+#include "detail/balance_policy.hpp"    // avl_balance, wavl_balance
+                                        // and weight_balance
+
+#include "detail/npsv_interval.hpp"     // Interval width type for
+                                        // for_each_overlapping()
+
+#include "detail/stream_codec.hpp"      // Default codec of save()
+                                        // and load()
+
+#include "detail/static_pool.hpp"       // Fixed capacity node
+                                        // pool and its allocator
+                                        // (for internal use only)
+
+#include "detail/small_buffer.hpp"      // Storage and iterators
+                                        // of small_avl_array
+                                        // (for internal use only)
+
 #include "detail/iterator.hpp"          // Normal iterators
 #include "detail/iterator_reverse.hpp"  // Reverse iterators
+#include "detail/iterator_algo.hpp"     // distance(), advance(),
+                                        // lower_bound()... (ADL)
 
 #include "detail/node.hpp"              // Generic node of the tree
 #include "detail/node_with_data.hpp"    // Node+data (all but end)
                                         // (for internal use only)
 
+#include "detail/intrusive_hook.hpp"    // Hook for user objects,
+                                        // and intrusive nodes
+
                                         // Temporary container of
                                         // nodes in massive
 #include "detail/rollback_list.hpp"     // operations, used for
@@ -107,9 +154,10 @@ template<class T,                       // The container class
          bool bW=false,
          class W=std::size_t,
          bool bP=false,
-         class P=std::size_t>
+         class P=std::size_t,
+         class B=avl_balance>
 class avl_array
-  : private avl_array_node_tree_fields<T,A,bW,W,bP,P>
+  : private avl_array_node_tree_fields<T,A,bW,W,bP,P,B>
 {
 
   // -------------------------- TYPES ----------------------------
@@ -117,31 +165,35 @@ class avl_array
   public:
 
     typedef avl_array_node_tree_fields<T,A,bW,
-                                       W,bP,P>   node_t;
-    typedef avl_array_node<T,A,bW,W,bP,P>        payload_node_t;
-    typedef avl_array<T,A,bW,W,bP,P>             my_class;
-    typedef rollback_list<T,A,bW,W,bP,P>         rollback_list_t;
-
-    typedef typename A::value_type               value_type;
-    typedef typename A::reference                reference;
-    typedef typename A::const_reference          const_reference;
-    typedef typename A::pointer                  pointer;
-    typedef typename A::const_pointer            const_pointer;
+                                       W,bP,P,B> node_t;
+    typedef avl_array_node<T,A,bW,W,bP,P,B>      payload_node_t;
+    typedef avl_array<T,A,bW,W,bP,P,B>           my_class;
+    typedef rollback_list<T,A,bW,W,bP,P,B>       rollback_list_t;
+    typedef aa_alloc_traits<A,payload_node_t>    alloc_traits_t;
+
+    typedef typename alloc_traits_t::value_type  value_type;
+    typedef typename alloc_traits_t::reference   reference;
+    typedef typename
+            alloc_traits_t::const_reference      const_reference;
+    typedef typename alloc_traits_t::pointer     pointer;
+    typedef typename
+            alloc_traits_t::const_pointer        const_pointer;
 
     typedef std::ptrdiff_t                       difference_type;
     typedef std::size_t                          size_type;
 
-    typedef avl_array_iterator<T,A,bW,W,bP,P,
+    typedef avl_array_iterator<T,A,bW,W,bP,P,B,
                            reference,pointer>    iterator;
-    typedef avl_array_iterator<T,A,bW,W,bP,P,
+    typedef avl_array_iterator<T,A,bW,W,bP,P,B,
                const_reference,const_pointer>    const_iterator;
-    typedef avl_array_rev_iter<T,A,bW,W,bP,P,
+    typedef avl_array_rev_iter<T,A,bW,W,bP,P,B,
                            reference,pointer>    reverse_iterator;
-    typedef avl_array_rev_iter<T,A,bW,W,bP,P,
+    typedef avl_array_rev_iter<T,A,bW,W,bP,P,B,
             const_reference,const_pointer> const_reverse_iterator;
 
-    typedef typename A::template
-            rebind<payload_node_t>::other        allocator_t;
+    typedef A                                    allocator_type;
+    typedef typename
+            alloc_traits_t::node_allocator       allocator_t;
 
 
   // ---------------------- CONCEPT CHECKS -----------------------
@@ -182,7 +234,10 @@ class avl_array
     // See detail/aa_constr_destr.hpp
     //
     // Default con.: empty avl_array (O(1))
+    // Allocator con.: empty avl_array using al (O(1))
     // Copy con.: copy of other avl_array (O(N))
+    // Copy con. with allocator: idem, using al (O(N))
+    // Move con.: steal the contents of other avl_array (O(1))
     // Vector con.: avl_array with n elements like t (O(N))
     // Vector def. con.: " with n default-constructed elem. (O(N))
     // Sequence con.: " with copies of [from,to) (O(N))
@@ -190,7 +245,12 @@ class avl_array
     // Destructor (O(N))
 
     avl_array ();
+    explicit avl_array (const A & al);
     avl_array (const my_class & a);
+    avl_array (const my_class & a, const A & al);
+#ifdef AA_CXX11
+    avl_array (my_class && a) noexcept;
+#endif
     avl_array (size_type n, const_reference t);
     avl_array (int       n, const_reference t);
     avl_array (long      n, const_reference t);
@@ -209,19 +269,36 @@ class avl_array
     // See detail/aa_assign.hpp
     //
     // Assignment operator (O(M+N), M to delete + N to copy)
+    // Move assignment: steal contents (O(M), or O(M+N)*)
     // swap(): interchange contents (O(1))
+    // (*) if allocators are different and don't propagate
 
     const my_class & operator= (const my_class & a);
+#ifdef AA_CXX11
+    my_class & operator= (my_class && a);
+#endif
     void swap (my_class & a);
 
 
+    // Allocator
+    // See detail/aa_alloc.hpp
+    //
+    // get_allocator(): get a copy of the allocator (O(1))
+    // set_arena_mode(): enable/disable O(1) clear (O(1))
+    // arena_mode(): get current arena mode (O(1))
+
+    A get_allocator () const;
+    void set_arena_mode (bool on);
+    bool arena_mode () const;
+
+
     // Size methods
     // See detail/aa_size.hpp
     //
     // size(): retrieve current size (O(1))
     // empty(): true if empty; false otherwise (O(1))
     // max_size(): estimated maximum size in theory (O(1))
-    // resize(n): change size (O(min{N, n log N}))
+    // resize(n): change size (O(|n-N| + log N))
     // resize(n,t): idem, but add copies of t  "
 
     size_type size () const;
@@ -296,7 +373,7 @@ class avl_array
     // it insert(t): insert anywhere (O(log N) with no rotations)
     // it insert(it,t): insert before (O(log N))
     // rit insert(rit,t): insert before* (O(log N))
-    // insert(it,n,t): vector-insert before (O(min{N, n log N}))
+    // insert(it,n,t): vector-insert before (O(n + log N))
     // insert(rit,n,t): vector-insert before**        "
     // insert(it,from,to): sequence-insert before     "
     // insert(rit,from,to): sequence-insert before**  "
@@ -334,7 +411,7 @@ class avl_array
     // See detail/aa_erase.hpp
     //
     // it/rit erase(it/rit): (O(log N))
-    // it erase(it,n): vector-erase (O(min{N, n log N}))
+    // it erase(it,n): vector-erase (O(n + log N))
     // rit erase(rit,n): vector-erase (reverse)    "
     // it erase(from,to): range-erase              "
     // rit erase(rfrom,rto): range-erase (reverse) "
@@ -352,6 +429,24 @@ class avl_array
     void clear ();
 
 
+    // Batched updates
+    // See detail/aa_batch.hpp
+    //
+    // apply_batch(): erase and insert at many sorted positions
+    //                (O(min{N+K, K log N}))
+    // begin_batch(): start deferring rebalancing (O(1))
+    // end_batch(): settle deferred rebalancing (O(min{N, D+K log K}))
+    // in_batch(): tell whether rebalancing is deferred (O(1))
+
+    template <class EIT, class IIT>
+    void apply_batch (EIT erase_from, EIT erase_to,
+                      IIT insert_from, IIT insert_to);
+
+    void begin_batch ();
+    void end_batch ();
+    bool in_batch () const;
+
+
     // Double ended queue interface support
     // See detail/aa_front_back.hpp
     //
@@ -382,8 +477,7 @@ class avl_array
     //                                (O(1), O(log N) with NPSV)
     // move(it/rit,n): offset move (O(log N))
     // move(it/rit,it/rit): individual move O(log(M)+log(N))
-    // move(it/rit,n,it/rit): group move O(min{N, n log N} +
-    //                                     min{M, n log M})
+    // move(it/rit,n,it/rit): group move O(n + log N + log M)
     // move(it/rit,it/rit,it/rit): range move    "
     // splice(it/rit,cont): group move (see above)
     // splice(it/rit,cont,it/rit): individual move (see above)
@@ -460,6 +554,8 @@ class avl_array
     //
     // binary_search(): fast search* (O(log N))
     // insert_sorted(): insert keeping order* (O(log N))
+    // insert_sorted(from,to): idem, a whole sequence*
+    //                              (O(min{N+K log K, K log N}))
     // sort(): impose order                          (O(N log N))
     // stable_sort(): idem + keep current order between equals "
     // merge(): mix two containers, keeping order* (O(M+N))
@@ -500,6 +596,15 @@ class avl_array
     iterator insert_sorted (const_reference t,
                             bool allow_duplicates=true);
 
+    template<class IT, class CMP>
+    size_type insert_sorted (IT from, IT to,
+                             bool allow_duplicates,
+                             CMP cmp);
+
+    template<class IT>
+    size_type insert_sorted (IT from, IT to,
+                             bool allow_duplicates);
+
     template<class CMP>
     void sort (CMP cmp);
 
@@ -521,6 +626,117 @@ class avl_array
     void unique ();
 
 
+    // Radix sort (integral elements or keys)
+    // See detail/aa_radix_sort.hpp
+    //
+    // radix_sort(): sort integral elements (O(N*sizeof(T)))
+    // radix_sort(key): sort by an integral key (O(N*sizeof(key)))
+
+    template<class KEY>
+    void radix_sort (KEY key);
+
+    void radix_sort ();
+
+
+    // Selection (partial sorting)
+    // See detail/aa_select.hpp
+    //
+    // nth_element(): put the n'th element in place (O(N) expected)
+    // partial_sort(): sort only the first k elements
+    //                                   (O(N + k log k) expected)
+    // top_k(): copy the first k of the sorted sequence (O(N log k))
+
+    template<class CMP>
+    iterator nth_element (size_type n, CMP cmp);
+    iterator nth_element (size_type n);
+    template<class CMP>
+    iterator nth_element (const iterator & pos, CMP cmp);
+    iterator nth_element (const iterator & pos);
+
+    template<class CMP>
+    void partial_sort (size_type k, CMP cmp);
+    void partial_sort (size_type k);
+
+    template<class CMP, class OIT>
+    OIT top_k (size_type k, CMP cmp, OIT out) const;
+    template<class OIT>
+    OIT top_k (size_type k, OIT out) const;
+
+
+    // Filtering and partitioning
+    // See detail/aa_partition.hpp
+    //
+    // erase_if(): erase elements satisfying a predicate (O(N))
+    // remove_if(): same as erase_if() (std::list interface)
+    // partition(): put first those satisfying a pred. (O(N))
+    // stable_partition(): idem (partition() is stable too) (O(N))
+
+    template<class PRED>
+    size_type erase_if (PRED pred);
+
+    template<class PRED>
+    size_type remove_if (PRED pred);
+
+    template<class PRED>
+    iterator partition (PRED pred);
+
+    template<class PRED>
+    iterator stable_partition (PRED pred);
+
+
+    // Parallel traversal and copy (threads only with
+    // AA_USE_THREADS)
+    // See detail/aa_parallel.hpp
+    //
+    // parallel_for_each(): call f for every element (O(N/th + th log N))
+    // parallel_reduce(): combine all elements with op     "
+    // parallel_assign(): copy another avl_array or a random access
+    //                    sequence (O(M + N/th + N))
+    // (where th is the number of threads; 0 means "hardware
+    // threads")
+
+    template<class F>
+    static void parallel_for_each (iterator first,
+                                   iterator last,
+                                   F f,
+                                   unsigned nthreads=0);
+    template<class F>
+    static void parallel_for_each (const_iterator first,
+                                   const_iterator last,
+                                   F f,
+                                   unsigned nthreads=0);
+
+    template<class V, class OP>
+    static V parallel_reduce (const_iterator first,
+                              const_iterator last,
+                              V init,
+                              OP op,
+                              unsigned nthreads=0);
+
+    void parallel_assign (const my_class & a,
+                          unsigned nthreads=0);
+
+    template <class RAIT>
+    void parallel_assign (RAIT from, RAIT to,
+                          unsigned nthreads=0);
+
+
+    // Memory locality
+    // See detail/aa_compact.hpp
+    //
+    // compact_memory(): reallocate all nodes in order (O(N))
+    // compact_memory(from,n): idem, n nodes at a time (O(log N+n))
+
+    void compact_memory ();
+    template<class F>
+    void compact_memory (F remap);
+
+    size_type compact_memory (size_type from, size_type n);
+    template<class F>
+    size_type compact_memory (size_type from, size_type n,
+                              F remap);
+
+
     // Non-Proportional Sequence View
     // See detail/aa_npsv.hpp
     //
@@ -531,6 +747,11 @@ class avl_array
     // npsv_pos_of(): get an element's position O(log N) or O(N)*
     // npsv_at_pos(): get elem. of a position O(log N) or O(N)*
     // npsv_insert(): insert and set width O(log N)
+    // npsv_sample(): draw k elements, weighted by their widths
+    //                O(k log k + min{N, k log N})
+    // for_each_overlapping(): call f for every width (interval)
+    //                         overlapping [lo,hi]
+    //                         O(min{N, (k+1) log N})*
     // (*) width sums need to be updated
     // (**) don't update width sums (lazy mode)
 
@@ -558,20 +779,61 @@ class avl_array
     iterator npsv_insert (const iterator & it,
                           const_reference t, const W & w);
 
+    template<class RNG, class OIT>
+    OIT npsv_sample (RNG & rng, size_type k, OIT out,
+                     bool with_replacement=true);
+
+    template<class E, class F>
+    F for_each_overlapping (const E & lo, const E & hi, F f);
+
+    template<class E, class F>
+    F for_each_overlapping (const E & lo, const E & hi,
+                            F f) const;
+
+
+    // Serialization
+    // See detail/aa_serialize.hpp
+    //
+    // save(): write elements (and NPSV widths) (O(N))
+    // load(): replace the contents with saved data (O(N))
+
+    void save (std::ostream & os) const;
+    template<class C>
+    void save (std::ostream & os, C codec) const;
+
+    void load (std::istream & is);
+    template<class C>
+    void load (std::istream & is, C codec);
+
 
   // ------------------------- FRIENDS ---------------------------
 
   private:
 
-  friend class avl_array_iterator<T,A,bW,W,bP,P,reference,pointer>;
-  friend class avl_array_iterator<T,A,bW,W,bP,P,const_reference,
+  friend class avl_array_iterator<T,A,bW,W,bP,P,B,reference,pointer>;
+  friend class avl_array_iterator<T,A,bW,W,bP,P,B,const_reference,
                                                 const_pointer>;
 
-  friend class avl_array_rev_iter<T,A,bW,W,bP,P,reference,pointer>;
-  friend class avl_array_rev_iter<T,A,bW,W,bP,P,const_reference,
+  friend class avl_array_rev_iter<T,A,bW,W,bP,P,B,reference,pointer>;
+  friend class avl_array_rev_iter<T,A,bW,W,bP,P,B,const_reference,
                                                 const_pointer>;
 
-  friend class rollback_list<T,A,bW,W,bP,P>;
+  friend class rollback_list<T,A,bW,W,bP,P,B>;
+
+  template<class AA, class NP, class WK>
+  friend class chunk_job;
+  template<class AA, class NP, class DP, class IT>
+  friend class build_job;
+
+  template<class U, std::size_t S, bool bV, class V, bool bQ,
+           class Q>
+  friend class mkr::static_avl_array;
+
+  template<class U, class G, bool bV, class V, bool bQ, class Q>
+  friend class mkr::intrusive_avl_array;
+
+  template<class U, class V, std::size_t S>
+  friend class mkr::buffered_avl_array;
 
 
   // ----------------------- PRIVATE DATA ------------------------
@@ -584,6 +846,12 @@ class avl_array
     mutable bool m_sums_out_of_date;  // If true: NPSV sums must
                                       // be recalculated
 
+    bool m_arena;            // If true: don't destroy nodes in
+                             // clear() (when T needs no destr.)
+
+    bool m_in_batch;         // If true: rebalancing deferred
+    size_type m_batch_edits; // Edits since begin_batch()
+
 
   // ------------------ PRIVATE HELPER METHODS -------------------
 
@@ -629,10 +897,16 @@ class avl_array
     //
     // new_node(): Allocate and construct a new node (O(1))
     // delete_node(): Destruct and deallocate a node (O(1))
+    // same_allocator(): check that nodes can go from a tree
+    //                   to another (O(1), or O(log N) with
+    //                   stateful allocators)
 
     node_t * new_node (const_pointer t=NULL);
     void delete_node (node_t * p);
 
+    static void same_allocator (const node_t * p,
+                                const node_t * q);
+
 
     // Tree balance methods
     // See detail/aa_balance.hpp
@@ -645,9 +919,27 @@ class avl_array
     //   climb from a node to the root updating all height and
     //   count fields in the way _and_ rebalancing with AVL
     //   rotations where required                   (O(log N))
+    //   (or the following ones, depending on B)
+    //
+    // wavl_rebalance():
+    //   the same with wavl_balance                 (O(log N))
+    //
+    // weight_rebalance():
+    //   the same with weight_balance               (O(log N))
+    //
+    // rotate(): single rotation of a subtree       (O(1))
+    // update_node(): update the fields of a node   (O(1))
+    // balance_key(): height or weight of a subtree (O(1))
+    // out_of_balance(): compare two balance keys   (O(1))
 
     static void update_counters (node_t * p);
     static void update_counters_and_rebalance (node_t * p);
+    static void wavl_rebalance (node_t * p);
+    static void weight_rebalance (node_t * p);
+    static node_t * rotate (node_t * p, int s);
+    static void update_node (node_t * p);
+    static size_type balance_key (const node_t * p);
+    static bool out_of_balance (size_type x, size_type y);
 
 
     // Helper methods for erasing nodes (or just moving...)
@@ -655,8 +947,8 @@ class avl_array
     //
     // extract_node(): remove a node (O(1)) [+ later rebalance]
     // erase_it(IT): delete one element (O(log N))
-    // extract_nodes(): remove n nodes (O(min{N, n log N})
-    // erase_it(IT,n): delete n elements (O(min{N, n log N})
+    // extract_nodes(): remove n nodes (O(n + log N))
+    // erase_it(IT,n): delete n elements (O(n + log N))
 
     static node_t * extract_node (node_t * p);
 
@@ -674,15 +966,6 @@ class avl_array
 
        node_t * dst=NULL,           // Destination to check
 
-       bool * delayed_rebuild=NULL, // In: non-NULL means "delay
-                                    // tree reconstruction, cause
-                                    // the same tree is used for
-                                    // destination"
-                                    // Out: true means "reconstr.
-                                    // was delayed and the caller
-                                    // should do it after
-                                    // reinsertion"
-
        bool reverse=false);         // true means: "destination
                                     // has been secified with a
                                     // reverse iterator, so build
@@ -693,6 +976,30 @@ class avl_array
                  size_type n); // Number of elements to erase
 
 
+    // Helper methods for batched updates
+    // See detail/aa_batch.hpp
+    //
+    // check_batch_erase(): validate batch erase positions (O(K))
+    // check_batch_insert(): validate batch insert positions (O(K))
+    // batch_insert(): insert a node, deferring updates (O(1)*)
+    // batch_extract(): extract a node, deferring updates (O(1)*)
+    // mark_dirty(): mark a node and its ancestors as dirty (O(1)*)
+    // settle_dirty(): update and rebalance dirty nodes (O(D+K log K))
+    //   (*) amortized over the paths touched in the batch
+
+    template <class EIT>
+    static size_type check_batch_erase (EIT from, EIT to,
+                                        size_type N);
+    template <class IIT>
+    static size_type check_batch_insert (IIT from, IIT to,
+                                         size_type N);
+
+    void batch_insert (node_t * newnode, node_t * p);
+    void batch_extract (node_t * p);
+    static void mark_dirty (node_t * p);
+    void settle_dirty ();
+
+
     // Helper methods for random access
     // See detail/aa_random_access.hpp
     //
@@ -715,17 +1022,22 @@ class avl_array
     // See detail/aa_assign.hpp
     //
     // acquire_tree(): steal the tree of another avl_array (O(1))
+    // steal_contents(): idem, and leave it empty (O(1))
 
     void acquire_tree (const node_t & nf);
+    void steal_contents (my_class & a);
 
 
     // Helper methods for insertion
     // See detail/aa_insert.hpp
     //
     // insert_before(): insert a node in a given pos. (O(log N))
+    // link_before(): link a node in a given pos., no update (O(1))
     // insert_anywhere(): add a node to the tree (O(log N))
 
-    static void insert_before (node_t * newnode, node_t * p);
+    static void insert_before (node_t * newnode, node_t * p,
+                               bool label=true);
+    static node_t * link_before (node_t * newnode, node_t * p);
     void insert_anywhere (node_t * newnode);
 
 
@@ -742,6 +1054,7 @@ class avl_array
     //
     // worth_rebuild(): decide how to perform a massive op. (O(1))
     // build_known_size_tree(): make a tree of a given size (O(N))
+    // build_subtree(): make a detached subtree of a given size (O(n))
 
     static bool worth_rebuild (         // Return: true=rebuild
                      size_type n,       // Elements to insert/erase
@@ -752,6 +1065,11 @@ class avl_array
                        (size_type n,    // Total number of nodes
                         node_t * next); // List with nodes to link
 
+    static node_t * build_subtree       // Return its root
+                       (size_type n,    // Number of nodes
+                        node_t *& next, // List with nodes to link
+                        node_t * last); // Insert after it (list)
+
 
     // Helper method for massive operations (temp. lists)
     // See detail/aa_build_list.hpp
@@ -776,7 +1094,7 @@ class avl_array
     // move_node(): move n places along the sequence (O(log N))
     // move_node(): extract and insert in other pos. (O(log N))
     // move_nodes(): move n nodes to another pos.
-    //                                        (O(min{N, n log N})
+    //                                        (O(n + log N))
 
     static void swap_nodes (node_t * p, node_t * q);
     static void move_node (node_t * p, difference_type n);
@@ -789,10 +1107,11 @@ class avl_array
                             bool reverse=false);
 
 
-    // Helper method for sorting and searching
+    // Helper methods for sorting and searching
     // See detail/aa_sorted_search_tree.hpp
     //
     // binary_search(): search value in a sorted tree (O(log N))
+    // finger_search(): search starting at a given node (O(log d))
 
     template<class CMP>
     bool binary_search             // Return true iff it is found
@@ -803,16 +1122,198 @@ class avl_array
          bool stable=false)
                         const;
 
+    template<class CMP>
+    node_t * finger_search         // Return the first greater node
+        (const_reference t,        // What to search
+         node_t * f,               // Where to start (not greater)
+         CMP cmp);                 // Functor for '<' comparisons
 
-    // Helper method for massive resize operations
-    // See detail/aa_size.hpp
+
+    // Helper method for filtering and partitioning
+    // See detail/aa_partition.hpp
+    //
+    // partition_nodes(): relink nodes in two groups (O(N))
+
+    template<class PRED>
+    node_t * partition_nodes (PRED pred);  // Return 1st of 2nd group
+
+
+    // Helper methods for parallel traversal and copy
+    // See detail/aa_parallel.hpp
+    //
+    // thread_count(): number of threads to use (O(1))
+    // run_jobs(): run k jobs in several threads (O(k) + jobs)
+    // chunk_start(): position of a chunk in a range (O(1))
+    // split_range(): cut a range in balanced chunks (O(k log N))
+    // run_chunks(): process the chunks in several threads
+    // run_chunk(): process a single chunk (O(chunk size))
+    // parallel_build(): construct chunks of nodes in several
+    //                   threads and build the tree with them
+
+    static unsigned thread_count (unsigned nthreads);
+
+    template<class JOB>
+    static void run_jobs (JOB & job,
+                          size_type k,
+                          unsigned nthreads);
+
+    static size_type chunk_start (size_type n,
+                                  size_type k,
+                                  size_type i);
+
+    static void split_range (node_t * first,
+                             size_type n,
+                             size_type k,
+                             std::vector<node_t*> & bounds);
+
+    template<class WK>
+    static void run_chunks (node_t * first,
+                            node_t * last,
+                            WK & worker,
+                            unsigned nthreads);
+
+    template<class WK>
+    static void run_chunk (WK & worker,
+                           size_type c,
+                           node_t * from,
+                           node_t * to);
+
+    template<class DP, class IT>
+    void parallel_build (const std::vector<IT> & starts,
+                         size_type n,
+                         unsigned nthreads);
+
+
+    // Helper methods for weighted sampling and interval queries
+    // See detail/aa_npsv.hpp
     //
-    // resize(n,DP): change size (rebuild)
-    //                                 O(max{old_size,new_size})
+    // npsv_sample_nodes(): find sorted positions in a subtree
+    //                      (O(min{n, k log n}))
+    // for_each_overlapping_nodes(): visit the overlapping
+    //                      widths of a subtree (O(min{n, (k+1) log n}))
 
-    template<class DP>
-    void resize (size_type n, DP & dp);
+    template<class OIT>
+    OIT npsv_sample_nodes (node_t * p, W offset,
+                           const W * from, const W * to,
+                           OIT out);
 
+    template<class IT, class F>
+    static void for_each_overlapping_nodes (node_t * p,
+                                            const W & q, F & f);
+
+
+    // Helper methods for serialization
+    // See detail/aa_serialize.hpp
+    //
+    // save_stream(): write header, elements and widths (O(N))
+    // load_stream(): read them and build the tree (O(N))
+
+    template<class C>
+    void save_stream (std::ostream & os, C & codec,
+                      size_type elem_size) const;
+
+    template<class C>
+    void load_stream (std::istream & is, C & codec,
+                      size_type elem_size);
+
+
+    // Helper methods for joining and splitting trees
+    // See detail/aa_join_split.hpp
+    //
+    // join_trees(): join two subtrees and a node (O(|h1-h2|+1))
+    // split_tree(): split a subtree at a position (O(log N))
+    // append_nodes(): add n nodes at one end (O(n + log N))
+    // detach_nodes(): take out n nodes from one end
+    //                                          (O(n + log N))
+    // link_nodes_before(): add n nodes before a given one
+    //                                          (O(n + log N))
+    // cut_nodes(): take n consecutive nodes out of the tree
+    //              (not out of the list) (O(log N))
+    // unlinked_data(): get the data of an unlinked node (O(1))
+
+    static node_t * join_trees (node_t * a, node_t * k,
+                                node_t * b);
+    static void split_tree (node_t * t, size_type n,
+                            node_t *& l, node_t *& r);
+    void append_nodes (node_t * const * v, size_type n,
+                       bool front);
+    void detach_nodes (node_t ** v, size_type n, bool front);
+    void link_nodes_before (node_t * first, size_type n,
+                            node_t * p);
+    void cut_nodes (size_type pos, size_type n);
+    static reference unlinked_data (node_t * p);
+
+
+    // Helper methods for intrusive_avl_array
+    // See detail/aa_intrusive.hpp
+    //
+    // link_node(): insert an unlinked node (O(log N))
+    // unlink_node(): take a node out, leaving it unlinked (O(log N))
+    // unlink_all(): take all nodes out, leaving them unlinked (O(N))
+    // iterator_of(): get an iterator referring a node (O(1))
+
+    iterator link_node (node_t * n, iterator it);
+    iterator unlink_node (iterator it);
+    void unlink_all ();
+    static iterator iterator_of (node_t * p);
+
+
+    // Helper methods for memory compaction
+    // See detail/aa_compact.hpp
+    //
+    // relocate_nodes(): reallocate n consecutive nodes (O(n))
+    // no_remap(): remap functor that does nothing (O(1))
+
+    template<class F>
+    node_t * relocate_nodes (node_t * p, size_type n, F remap);
+    static void no_remap (const_iterator, iterator);
+
+
+    // Helper methods for radix sort
+    // See detail/aa_radix_sort.hpp
+    //
+    // radix_sort_by(): the sort itself, given the type of the key
+    // radix_byte(): get one digit of a key (O(1))
+
+    template<class KEY, class K>
+    void radix_sort_by (KEY key, K k0);
+    template<class K>
+    static int radix_byte (K k, int d, bool top);
+
+
+    // Helper methods for selection
+    // See detail/aa_select.hpp
+    //
+    // select_nodes(): introselect on a list of nodes (O(n) exp.)
+    // sort_nodes(): stable merge sort of a list (O(n log n))
+    // merge_nodes(): merge two sorted lists of nodes (O(n))
+
+    template<class CMP>
+    static node_t * select_nodes (node_t * first, size_type n,
+                                  size_type t, CMP cmp);
+    template<class CMP>
+    static node_t * sort_nodes (node_t * first, CMP cmp);
+    template<class CMP>
+    static node_t * merge_nodes (node_t * a, node_t * b, CMP cmp);
+
+
+    // Helper methods for order-maintenance labels (with bP)
+    // See detail/aa_order.hpp
+    //
+    // label_node(): label a newly linked node
+    //                                (O(1), amortized O(log N))
+    // relabel_nodes(): spread n labels evenly in a range (O(n))
+    // relabel_all(): spread all labels in the whole range (O(N))
+    // node_precedes(): compare the positions of two nodes
+    //                               (O(1) with bP, else O(log N))
+
+    static void label_node (node_t * p);
+    static void relabel_nodes (node_t * p, size_type n,
+                               P lo, P hi);
+    void relabel_all ();
+    static bool node_precedes (const node_t * a,
+                               const node_t * b,
+                               bool reverse);
 };
 
 //////////////////////////////////////////////////////////////////
@@ -839,6 +1340,7 @@ class avl_array
 #include "detail/aa_balance.hpp" // Counters update and AVL balance
 #include "detail/aa_insert.hpp"  // insert()
 #include "detail/aa_erase.hpp"   // erase(), clear()
+#include "detail/aa_batch.hpp"   // apply_batch(), begin_batch()...
 #include "detail/aa_move.hpp"   // move/splice(), swap(), reverse()
 #include "detail/aa_size.hpp"   // size(), max_size(), resize()...
 
@@ -848,7 +1350,23 @@ class avl_array
                                          // insert_sorted(),
                                         // merge(), unique()
 
+#include "detail/aa_radix_sort.hpp" // radix_sort()
+#include "detail/aa_select.hpp"     // nth_element(), top_k()...
+#include "detail/aa_partition.hpp" // erase_if(), partition()...
+#include "detail/aa_parallel.hpp"  // parallel_for_each(), ...
+#include "detail/aa_join_split.hpp" // join_trees(), split_tree()
+#include "detail/aa_intrusive.hpp" // link_node(), unlink_node()...
+#include "detail/aa_compact.hpp"   // compact_memory()
+#include "detail/aa_order.hpp"     // Order-maintenance labels
+
 #include "detail/aa_npsv.hpp"   // Non Proportional Sequence View
+#include "detail/aa_serialize.hpp" // save(), load()
+
+#include "detail/static_avl_array.hpp" // Fixed capacity avl_array
+#include "detail/intrusive_avl_array.hpp" // Intrusive avl_array
+#include "detail/small_avl_array.hpp" // Inline buffer or tree
+#include "detail/frozen_avl_view.hpp" // Contiguous snapshot
+#include "detail/buffered_avl_array.hpp" // Buffered ends
 
 // (Other headers, containing detail classes
 // are included from the beginning of this file)
@@ -858,6 +1376,7 @@ class avl_array
 #undef AA_ASSERT
 #undef AA_ASSERT_HO
 #undef AA_ASSERT_EXC
+#undef AA_CXX11
 
 //////////////////////////////////////////////////////////////////
 
@@ -10,10 +10,19 @@
   detail/aa_alloc.hpp
   -------------------
 
+  Methods for the allocator:
+
+  get_allocator(): get a copy of the allocator (O(1))
+  set_arena_mode(): enable/disable O(1) clear (O(1))
+  arena_mode(): get current arena mode (O(1))
+
   Private helper methods for nodes allocation/deallocation
 
   new_node(): Allocate and construct a new node (O(1))
   delete_node(): Destruct and deallocate a node (O(1))
+  same_allocator(): check that nodes can go from a tree to
+                    another (O(1), or O(log N) with stateful
+                    allocators)
 */
 
 #ifndef _AVL_ARRAY_ALLOC_HPP_
@@ -28,6 +37,53 @@ namespace mkr  // Public namespace
 
 //////////////////////////////////////////////////////////////////
 
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// get_allocator(): return a copy of the allocator, rebound
+// to value_type
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  A
+  avl_array<T,A,bW,W,bP,P,B>::get_allocator () const
+{
+  return A(allocator);
+}
+
+// set_arena_mode(): enable or disable the arena mode. In
+// arena mode, clear() and the destructor don't destroy and
+// deallocate the nodes one by one; they just forget them,
+// in O(1). This is only done if the nodes don't need to be
+// destroyed (T, W and P are trivially destructible, which
+// can only be known with C++11 type traits); otherwise the
+// arena mode is ignored. The memory is not returned to the
+// allocator, so this is only meant for allocators that
+// release all their memory at once, like one that uses an
+// std::pmr::monotonic_buffer_resource (whose deallocate()
+// does nothing anyway). Erasing single elements still
+// deallocates them normally.
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::set_arena_mode (bool on)
+{
+  m_arena = on;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  bool
+  avl_array<T,A,bW,W,bP,P,B>::arena_mode () const
+{
+  return m_arena;
+}
+
+
 // ------------------- PRIVATE HELPER METHODS --------------------
 
 // new_node(): Allocate and construct a new node. If the parameter
@@ -38,11 +94,11 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1) (regarded that T's constructor is O(1) ;)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::new_node
-  (typename avl_array<T,A,bW,W,bP,P>::const_pointer t)
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::new_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_pointer t)
 {
   payload_node_t * p;
 
@@ -51,10 +107,18 @@ inline
   if (p==NULL)                       // If the allocator didn't
     throw allocator_returned_null(); // throw an exception, but
                                      // it returned NULL, throw
-  if (t)
-    new (p) payload_node_t(*t);      // Call the constructor
-  else                               // through the placement
-    new (p) payload_node_t;          // new operator
+  try
+  {
+    if (t)
+      new (p) payload_node_t(*t);    // Call the constructor
+    else                             // through the placement
+      new (p) payload_node_t;        // new operator
+  }
+  catch (...)
+  {
+    allocator.deallocate (p, 1);     // Don't leak the memory if
+    throw;                           // the constructor throws
+  }
 
   return static_cast<node_t*>(p);    // Return allocated node
 }
@@ -63,10 +127,10 @@ inline
 //
 // Complexity: O(1) (regarded that T's destructor is O(1) ;)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array<T,A,bW,W,bP,P>::delete_node
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  avl_array<T,A,bW,W,bP,P,B>::delete_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   AA_ASSERT (p);
   payload_node_t * q = static_cast<payload_node_t*>(p);
@@ -74,6 +138,33 @@ inline void
   allocator.deallocate (q, 1);
 }
 
+// same_allocator(): check that the nodes p and q belong to
+// the same array, or to arrays with equal allocators, so
+// that nodes can be moved from one to the other. Otherwise,
+// throw allocator_mismatch. Allocators that are always
+// equal (like std::allocator) need no check at all.
+//
+// Complexity: O(1), or O(log N) with stateful allocators
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::same_allocator
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   const typename avl_array<T,A,bW,W,bP,P,B>::node_t * q)
+{
+  my_class * a, * b;
+
+  if (alloc_traits_t::always_equal)
+    return;
+
+  a = owner (p);
+  b = owner (q);
+
+  AA_ASSERT_EXC (a==b || a->allocator==b->allocator,
+                 allocator_mismatch());
+}
+
 //////////////////////////////////////////////////////////////////
 
 }  // namespace mkr
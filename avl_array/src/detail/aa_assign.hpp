@@ -13,11 +13,13 @@
   Container assignment and swap operations:
 
   Container assignment (O(M+N): M to delete + N to copy)
+  Move assignment (O(M), or O(M+N) if allocators don't match)
   Container swap (O(1))
 
-  Private helper method:
+  Private helper methods:
 
   acquire_tree(): steal the tree of another avl_array (O(1))
+  steal_contents(): idem, and leave it empty (O(1))
 */
 
 #ifndef _AVL_ARRAY_ASSIGN_HPP_
@@ -38,48 +40,142 @@ namespace mkr  // Public namespace
 // avl_array with a copy of the contents of a. The T
 // objects will be copied one by one, in sequence order,
 // using the T copy constructor. The resulting tree will be
-// perfectly balanced.
+// perfectly balanced. If the allocator propagates on copy
+// assignment (C++11 traits) and it is different, the new
+// nodes are built with a's allocator in a temporary array,
+// and the old ones are destroyed with the old allocator.
+// Either way, if something throws, *this is not modified.
 //
 // Complexity: O(M+N) (linear time)
 // (where M is the number of T objects to delete, and N is
 // the number of T objects to copy)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
-inline
-  const typename avl_array<T,A,bW,W,bP,P>::my_class &
-  avl_array<T,A,bW,W,bP,P>::operator=
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  const typename avl_array<T,A,bW,W,bP,P,B>::my_class &
+  avl_array<T,A,bW,W,bP,P,B>::operator=
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a)
 {
   node_t * first, * last;
   iter_aa_data_provider<const_pointer,
                         const_iterator, bW, W> dp(a.begin());
 
   if (&a == this) return *this;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
+  if (alloc_traits_t::propagate_on_copy &&
+      !(allocator==a.allocator))
+  {
+    my_class tmp(a, A(a.allocator));     // Copy with a's alloc.
+
+    clear ();                            // Old nodes, old alloc.
+    propagate_if<alloc_traits_t::propagate_on_copy>::
+      copy (allocator, a.allocator);
+    m_arena = a.m_arena;
+    steal_contents (tmp);
+    return *this;
+  }
+
   construct_nodes_list (first, last, a.size(), dp);
   clear ();
   build_known_size_tree (a.size(), first);
   return *this;
 }
 
+#ifdef AA_CXX11
+
+// Move assignment operator: replace the current contents
+// of the avl_array with the contents of a, leaving a empty.
+// If the allocator propagates on move assignment (like
+// std::allocator), or both allocators are equal, the tree
+// of a is just relinked to *this (no T object is touched,
+// and iterators follow the elements). Otherwise (like two
+// std::pmr allocators with different memory resources)
+// the nodes can't change hands, so the elements are copied
+// with the allocator of *this, and a is cleared.
+//
+// Complexity: O(M), or O(M+N) if the nodes are copied
+// (where M is the number of T objects to delete, and N is
+// the number of T objects in a)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::my_class &
+  avl_array<T,A,bW,W,bP,P,B>::operator=
+  (typename avl_array<T,A,bW,W,bP,P,B>::my_class && a)
+{
+  if (&a == this) return *this;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
+  if (alloc_traits_t::propagate_on_move ||
+      alloc_traits_t::always_equal ||
+      allocator==a.allocator)
+  {
+    clear ();                            // Old nodes, old alloc.
+    propagate_if<alloc_traits_t::propagate_on_move>::
+      move (allocator, a.allocator);
+    if (alloc_traits_t::propagate_on_move)
+      m_arena = a.m_arena;
+    steal_contents (a);
+  }
+  else
+  {
+    *this = static_cast<const my_class &>(a);  // Copy
+    a.clear ();
+  }
+
+  return *this;
+}
+
+#endif
+
 // swap(): interchange the contents of two avl_array
 // containers. This operation only requires changing some
-// pointers. T objects are not touched
+// pointers. T objects are not touched. If the allocator
+// propagates on swap (C++11 traits), the allocators (and
+// arena modes) are interchanged too. Otherwise, they must
+// be equal, or allocator_mismatch is thrown (like with
+// two std::pmr allocators with different resources)
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::swap
-  (typename avl_array<T,A,bW,W,bP,P>::my_class & a)
+  avl_array<T,A,bW,W,bP,P,B>::swap
+  (typename avl_array<T,A,bW,W,bP,P,B>::my_class & a)
 {
   node_t tmp;
+  size_type n;
+  bool b;
 
   if (&a == this) return;  // Self-swap is nonsense
 
+  if (alloc_traits_t::propagate_on_swap)
+  {
+    propagate_if<alloc_traits_t::propagate_on_swap>::
+      swap (allocator, a.allocator);
+    b = m_arena;
+    m_arena = a.m_arena;
+    a.m_arena = b;
+  }
+  else
+    AA_ASSERT_EXC (alloc_traits_t::always_equal ||
+                   allocator==a.allocator,
+                   allocator_mismatch());
+
   tmp = *dummy ();           // tmp <-- *this
   acquire_tree (*a.dummy()); // *this <-- a
   a.acquire_tree (tmp);      // a <-- tmp
+
+  b = m_in_batch;            // A batch in progress goes
+  m_in_batch = a.m_in_batch; // with the tree (the dirty
+  a.m_in_batch = b;          // nodes are in it)
+  n = m_batch_edits;
+  m_batch_edits = a.m_batch_edits;
+  a.m_batch_edits = n;
 }
 
 
@@ -90,11 +186,11 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::acquire_tree
-  (const typename avl_array<T,A,bW,W,bP,P>::node_t & nf)
+  avl_array<T,A,bW,W,bP,P,B>::acquire_tree
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t & nf)
 {
   if (!nf.m_children[L])   // If the tree to acquire is empty,
     init ();               // just initialize
@@ -107,11 +203,34 @@ inline
     node_t::m_next->m_prev = dummy ();
 
     if (bW)
-      node_t::m_total_width =                       // Copy total
+      *node_t::m_total_width =                      // Copy total
            node_t::m_children[L]->total_width ();   // width into
   }                                                 // dummy node
 }
 
+// steal_contents(): acquire the whole tree of another
+// avl_array (see acquire_tree()), together with its NPSV
+// dirty bit and its batch in progress, if any (the dirty
+// nodes go with the tree), and leave it empty. The
+// allocators must be equal (or already propagated)
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::steal_contents
+  (typename avl_array<T,A,bW,W,bP,P,B>::my_class & a)
+{
+  acquire_tree (*a.dummy());
+  m_sums_out_of_date = a.m_sums_out_of_date;
+  m_in_batch = a.m_in_batch;
+  m_batch_edits = a.m_batch_edits;
+  a.m_in_batch = false;
+  a.m_batch_edits = 0;
+  a.init ();
+}
+
 //////////////////////////////////////////////////////////////////
 
 }  // namespace mkr
@@ -20,6 +20,17 @@
     climb from a node to the root updating all height and
     count fields in the way _and_ rebalancing with AVL
     rotations where required                   (O(log N))
+
+  wavl_rebalance():
+    the same with wavl_balance                 (O(log N))
+
+  weight_rebalance():
+    the same with weight_balance               (O(log N))
+
+  rotate(): single rotation of a subtree       (O(1))
+  update_node(): update the fields of a node   (O(1))
+  balance_key(): height or weight of a subtree (O(1))
+  out_of_balance(): compare two balance keys   (O(1))
 */
 
 #ifndef _AVL_ARRAY_BALANCE_HPP_
@@ -41,10 +52,10 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
   void
-  avl_array<T,A,bW,W,bP,P>::update_counters
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  avl_array<T,A,bW,W,bP,P,B>::update_counters
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   size_type i, j;
 
@@ -76,16 +87,28 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 // not inline
   void
-  avl_array<T,A,bW,W,bP,P>::update_counters_and_rebalance
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  avl_array<T,A,bW,W,bP,P,B>::update_counters_and_rebalance
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   size_type i, j;
   int s;
   node_t * q, * r;
 
+  if (B::scheme==wavl_scheme)    // Other balancing policies
+  {                              // (see balance_policy.hpp)
+    wavl_rebalance (p);
+    return;
+  }
+
+  if (B::scheme==weight_scheme)
+  {
+    weight_rebalance (p);
+    return;
+  }
+
   while (p)                      // Climb until the root is
   {                              // reached
     i = p->left_height ();
@@ -269,6 +292,256 @@ template<class T,class A,bool bW,class W,bool bP,class P>
   }
 }
 
+// wavl_rebalance(): climb from a node to the root updating all
+// count fields in the way _and_ restoring the rank rule of
+// wavl_balance (see detail/balance_policy.hpp). Ranks are not
+// recomputed from the children: they change only where a node
+// breaks the rule. A rank difference of zero (after an
+// insertion or a join) is fixed with a promotion, or with a
+// rotation that ends it. A rank difference of three, or a
+// leaf of rank two (after an extraction), is fixed with a
+// demotion, or with a rotation that ends it. Therefore,
+// after an erase, there are two rotations at most.
+//
+// Complexity: O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::wavl_rebalance
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  node_t * c, * v;
+  size_type r, rl, rr;
+  int s;
+
+  while (p)                      // Climb until the root is
+  {                              // reached
+    if (p->m_parent)             // (don't re-balance dummy node)
+    {
+      r = p->m_height;
+      rl = p->left_height ();
+      rr = p->right_height ();
+
+      if (!rl && !rr)            // Leaves have rank one
+        p->m_height = 1;
+
+      else if (rl==r || rr==r)   // A child as high as p
+      {
+        s = rl==r ? L : R;       // (side of the high child)
+
+        if (r-(s==L?rr:rl)==1)   // Sibling one rank lower:
+          p->m_height ++;        // promote p (and go on)
+        else
+        {
+          c = p->m_children[s];
+          v = c->m_children[1-s];   // Inner grandchild
+
+          if (c->m_height - (c->m_children[s] ?
+                             c->m_children[s]->m_height : 0) == 1)
+          {
+            p->m_height --;         // Single rotation: c
+            p = rotate (p, 1-s);    // over p
+          }
+          else
+          {
+            v->m_height ++;         // Double rotation: v
+            c->m_height --;         // over c and p
+            p->m_height --;
+            rotate (c, s);
+            p = rotate (p, 1-s);
+          }
+        }
+      }
+      else if (r-rl==3 || r-rr==3)  // A child too low
+      {
+        s = r-rl==3 ? R : L;     // (side of the other child)
+        c = p->m_children[s];
+
+        if (r-c->m_height==2)    // Both children low:
+          p->m_height --;        // demote p (and go on)
+        else if (c->m_height - c->left_height () == 2 &&
+                 c->m_height - c->right_height () == 2)
+        {
+          p->m_height --;        // Both c's children low too:
+          c->m_height --;        // demote p and c (and go on)
+        }
+        else if (c->m_height - (c->m_children[s] ?
+                                c->m_children[s]->m_height :
+                                0) == 1)
+        {
+          c->m_height ++;        // Single rotation: c over p
+          p->m_height --;        // (if p becomes a leaf, its
+                                 // rank must be one)
+          if (!p->m_children[1-s] && !c->m_children[1-s])
+            p->m_height = 1;
+
+          p = rotate (p, 1-s);
+        }
+        else
+        {
+          v = c->m_children[1-s];   // Double rotation: the inner
+          v->m_height += 2;         // grandchild over c and p
+          c->m_height --;
+          p->m_height -= 2;
+          rotate (c, s);
+          p = rotate (p, 1-s);
+        }
+      }
+    }
+
+    update_node (p);             // Update counts of p (the
+    p = p->m_parent;             // subtree root) and step up
+  }
+}
+
+// weight_rebalance(): climb from a node to the root updating
+// all count and height fields in the way _and_ restoring the
+// rule of weight_balance (see detail/balance_policy.hpp) with
+// single or double rotations. One rotation per node is
+// enough after an insertion, an extraction or a join.
+//
+// Complexity: O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::weight_rebalance
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  const size_type delta = weight_balance::delta;
+  const size_type gamma = weight_balance::gamma;
+
+  node_t * c;
+  size_type wl, wr;
+  int s;
+
+  while (p)                      // Climb until the root is
+  {                              // reached
+    if (p->m_parent)             // (don't re-balance dummy node)
+    {
+      wl = p->left_count () + 1;
+      wr = p->right_count () + 1;
+
+      s = wl > wr*delta ? L :     // Side of the heavy
+          wr > wl*delta ? R : -1; // child, if any
+
+      if (s!=-1)
+      {
+        c = p->m_children[s];
+
+        if (c->m_children[1-s] &&      // Inner grandchild too
+            c->m_children[1-s]->m_count + 1 >=   // heavy for
+            ((c->m_children[s] ?                 // a single
+              c->m_children[s]->m_count : 0) + 1) * gamma)
+          rotate (c, s);               // rotation: double one
+
+        p = rotate (p, 1-s);
+      }
+    }
+
+    update_node (p);             // Update counts of p (the
+    p = p->m_parent;             // subtree root) and step up
+  }
+}
+
+// rotate(): rotate the subtree of p (not the dummy), so that
+// the child of p in the side opposite to s takes its place,
+// and p goes down to the side s. Then, update the counts of p
+// (but not the new root, that is returned). Ranks are left to
+// the caller.
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::rotate
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p, int s)
+{
+  node_t * c;
+
+  c = p->m_children[1-s];             // The child that goes up
+
+  p->m_children[1-s] = c->m_children[s];   // p adopts c's inner
+  if (p->m_children[1-s])                  // subtree
+    p->m_children[1-s]->m_parent = p;
+
+  c->m_parent = p->m_parent;          // c takes p's place
+  if (c->m_parent->m_children[L]==p)
+    c->m_parent->m_children[L] = c;
+  else
+    c->m_parent->m_children[R] = c;
+
+  c->m_children[s] = p;               // and adopts p
+  p->m_parent = c;
+
+  update_node (p);
+  return c;
+}
+
+// update_node(): update the count and width fields of a node
+// from its children's, and its height too (but not with
+// wavl_balance, where m_height is a rank)
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::update_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  size_type i, j;
+
+  if (B::scheme!=wavl_scheme)
+  {
+    i = p->left_height ();
+    j = p->right_height ();
+    p->m_height = (i>j?i:j) + 1;
+  }
+
+  p->m_count = p->left_count () + p->right_count () + 1;
+  p->update_width ();
+}
+
+// balance_key(): get what the balancing policy compares for
+// a subtree (NULL for the empty one): its weight (count plus
+// one) with weight_balance, or its height (or rank)
+// otherwise
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::balance_key
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  if (B::scheme==weight_scheme)
+    return p ? p->m_count + 1 : 1;
+  else
+    return p ? p->m_height : 0;
+}
+
+// out_of_balance(): tell whether a subtree with balance key x
+// is too big to be the sibling of one with balance key y
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  bool
+  avl_array<T,A,bW,W,bP,P,B>::out_of_balance
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type x,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type y)
+{
+  if (B::scheme==weight_scheme)
+    return x > y * size_type(weight_balance::delta);
+  else
+    return x > y + 1;
+}
+
 //////////////////////////////////////////////////////////////////
 
 }  // namespace mkr
@@ -0,0 +1,492 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_batch.hpp
+  -------------------
+
+  Methods for batched updates:
+
+  apply_batch(): erase and insert at many sorted positions
+                 (O(min{N+K, K log N}))
+  begin_batch(): start deferring rebalancing (O(1))
+  end_batch(): settle deferred rebalancing (O(min{N, D+K log K}))
+  in_batch(): tell whether rebalancing is deferred (O(1))
+
+  Private helper methods:
+
+  check_batch_erase(): validate batch erase positions (O(K))
+  check_batch_insert(): validate batch insert positions (O(K))
+  batch_insert(): insert a node, deferring updates (O(1)*)
+  batch_extract(): extract a node, deferring updates (O(1)*)
+  mark_dirty(): mark a node and its ancestors as dirty (O(1)*)
+  settle_dirty(): update and rebalance dirty nodes (O(D+K log K))
+  (*) amortized over the paths touched in the batch
+*/
+
+#ifndef _AVL_ARRAY_BATCH_HPP_
+#define _AVL_ARRAY_BATCH_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// apply_batch(): erase the elements whose positions are
+// given in [erase_from,erase_to), and insert the values
+// given in [insert_from,insert_to). The insertions are
+// (index,value) pairs (anything with members first and
+// second, like std::pair), and every value is inserted
+// before the element that had the given index. All
+// indexes refer to the sequence as it was _before_ the
+// batch, so the caller doesn't need to adjust them for
+// the previous operations of the batch. An insert index
+// equal to size() means "append at the end". Both ranges
+// must be sorted by index (ascending). Erase indexes must
+// be unique; insert indexes might be repeated (values
+// with the same index are inserted in the given order).
+// Both ranges are traversed twice, so forward iterators
+// are required.
+//
+// If there are 'few' operations, they are performed one
+// by one, walking through the tree from the previous
+// position to the next one (a finger), so that no search
+// starts from the root. Otherwise, the whole list is
+// processed in a single pass and the tree is rebuilt
+// with build_known_size_tree().
+//
+// If an index is out of range, or the ranges are not
+// sorted, index_out_of_bounds is thrown before touching
+// the array. If a T constructor throws, the array is not
+// modified either.
+//
+// Complexity: O(min{N+K, K log N})
+// (where K is the number of operations in the batch)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template <class EIT, class IIT>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::apply_batch
+  (EIT erase_from, EIT erase_to,       // Sorted indexes to erase
+   IIT insert_from, IIT insert_to)     // Sorted (index,value) to
+{                                      // insert
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< ForwardIteratorConcept<EIT> >();
+  function_requires< ForwardIteratorConcept<IIT> >();
+#endif
+
+  node_t * first, * last, * p, * q, * r, * dead;
+  batch_data_provider<const_pointer,IIT> dp(insert_from,
+                                            insert_to);
+  size_type N, ne, ni, pos, i;
+  bool ins;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
+  N = size ();
+  ne = check_batch_erase (erase_from, erase_to, N);
+  ni = check_batch_insert (insert_from, insert_to, N);
+
+  if (!ne && !ni)
+    return;
+
+  ni = construct_nodes_list (first, last, 0, dp, false, true);
+
+  if (!worth_rebuild(ne+ni,N))  // If there are 'few' operations
+  {
+    p = node_t::m_next;         // Finger: the original element
+    pos = 0;                    // whose index is pos. Nothing
+                                // after it has been touched yet
+
+    while (erase_from!=erase_to || first)
+    {
+      ins = first &&                           // Inserts go
+            (erase_from==erase_to ||           // first (before
+             !(size_type(*erase_from) <        // the element
+               size_type(insert_from->first))); // that is erased)
+
+      i = ins ? size_type(insert_from->first) :
+                size_type(*erase_from);
+
+      p = jump (p, difference_type(i-pos), false);  // Walk from
+      pos = i;                                      // the finger
+
+      if (ins)
+      {
+        q = first;               // Insert the next new node
+        first = first->m_next;   // before the finger
+        insert_before (q, p);
+        ++ insert_from;
+      }
+      else
+      {
+        q = p;                   // Erase the finger, and move
+        p = p->m_next;           // the finger to the next
+        pos ++;                  // original element
+        update_counters_and_rebalance (extract_node (q));
+        delete_node (q);
+        ++ erase_from;
+      }
+    }
+  }
+  else                          // If there are 'many' operations
+  {
+    node_t::m_prev->m_next = NULL; // Detach the whole tree and use
+    p = node_t::m_next;            // it as an independent list
+
+    q = dummy ();               // Tail of the new list (the
+    dead = NULL;                // dummy is just a placeholder)
+
+    for (pos=0; pos<=N; pos++)     // Merge the old list with the
+    {                              // new nodes in a single pass
+      while (first &&
+             size_type(insert_from->first)==pos)
+      {
+        q = q->m_next = first;     // Append new nodes that go
+        first = first->m_next;     // before the old node pos
+        ++ insert_from;
+      }
+
+      if (pos==N)
+        break;
+
+      if (erase_from!=erase_to &&
+          size_type(*erase_from)==pos)
+      {
+        r = p;                     // Set aside the erased
+        p = p->m_next;             // nodes (delete them when
+        r->m_next = dead;          // the tree is ok again)
+        dead = r;
+        ++ erase_from;
+      }
+      else
+      {
+        q = q->m_next = p;         // Keep the old node
+        p = p->m_next;
+      }
+    }
+
+    q->m_next = NULL;              // The dummy still points to
+                                   // the head of the new list
+    build_known_size_tree (N-ne+ni, node_t::m_next);
+
+    while (dead)                   // Destroy removed nodes
+    {
+      p = dead;
+      dead = dead->m_next;
+      delete_node (p);
+    }
+  }
+}
+
+
+// begin_batch(): start a batch of edits with deferred
+// rebalancing. Until end_batch(), every single-element
+// insert(it,t), erase(it), push_* and pop_* links or
+// unlinks its node in O(1), and only marks as dirty the
+// path from there to the root (stopping at the first node
+// that is already dirty, so a batch marks each node once).
+// Counts, heights and NPSV widths of dirty nodes are stale
+// until end_batch() settles them all at once. This pays
+// off when the edits are close to each other (their paths
+// overlap); for edits scattered all over a big array, it
+// costs about the same as updating after every edit.
+//
+// Inside a batch, only those operations, iteration with
+// ++ and --, dereferencing, front(), back(), size() and
+// empty() are allowed. Everything based on positions
+// (operator[], at(), iterator arithmetic and differences,
+// position queries, NPSV queries), and any other
+// modifying method, must wait until end_batch(). With
+// bP, iterator comparisons (order labels) are still
+// valid. The destructor and clear() are fine too. A move
+// construction, move assignment or swap() takes the batch
+// along with the tree, so the array that gets the tree is
+// the one that must end it.
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::begin_batch ()
+{
+  AA_ASSERT (!m_in_batch);  // Batches don't nest
+
+  m_in_batch = true;
+  m_batch_edits = 0;
+}
+
+// end_batch(): finish a batch of edits (see begin_batch()).
+// If the batch was big enough, compared with the size of
+// the array (see worth_rebuild()), the whole tree is
+// rebuilt in perfect balance. Otherwise, only the dirty
+// nodes are visited, bottom-up, and every one of them is
+// joined again with its (already settled) subtrees. The
+// join rebalances any difference of height, however big,
+// so a burst of edits at the same place is fine too.
+//
+// Complexity: O(min{N, D + K log K}), where D is the number
+//             of dirty nodes (the union of the touched
+//             paths) and K the number of edits in the batch
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void avl_array<T,A,bW,W,bP,P,B>::end_batch ()
+{
+  AA_ASSERT (m_in_batch);   // No batch started
+
+  m_in_batch = false;
+
+  if (worth_rebuild (m_batch_edits, size (), false))
+    build_known_size_tree (size (), node_t::m_next);
+  else
+    settle_dirty ();
+
+  m_batch_edits = 0;
+}
+
+// in_batch(): tell whether a batch of edits is in progress
+// (see begin_batch())
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  bool avl_array<T,A,bW,W,bP,P,B>::in_batch () const
+{
+  return m_in_batch;
+}
+
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// check_batch_erase(): count the erase positions of a batch,
+// and throw index_out_of_bounds if they are not strictly
+// ascending or some of them falls out of [0,N)
+//
+// Complexity: O(K)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template <class EIT>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::check_batch_erase
+  (EIT from, EIT to,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type N)
+{
+  size_type n, prev=0;
+
+  for (n=0; from!=to; ++from, n++)
+  {
+    AA_ASSERT_EXC (size_type(*from)<N &&
+                   (!n || prev<size_type(*from)),
+                   index_out_of_bounds());
+    prev = *from;
+  }
+
+  return n;
+}
+
+// check_batch_insert(): count the insert positions of a
+// batch, and throw index_out_of_bounds if they are not
+// ascending or some of them falls out of [0,N]
+//
+// Complexity: O(K)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template <class IIT>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::check_batch_insert
+  (IIT from, IIT to,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type N)
+{
+  size_type n, prev=0;
+
+  for (n=0; from!=to; ++from, n++)
+  {
+    AA_ASSERT_EXC (size_type(from->first)<=N &&
+                   (!n || !(size_type(from->first)<prev)),
+                   index_out_of_bounds());
+    prev = from->first;
+  }
+
+  return n;
+}
+
+// batch_insert(): insert a node before p during a batch (see
+// begin_batch()). The node is linked as a leaf, and its new
+// parent is marked as dirty, instead of updating and
+// rebalancing the way up. The dummy's count is kept exact,
+// so that size() still works.
+//
+// Complexity: O(1) amortized over the paths touched in the
+//             batch (O(log N) the first time)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::batch_insert
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * newnode,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  node_t * parent;
+
+  parent = link_before (newnode, p);
+
+  if (bP)                         // Labels don't depend on
+    label_node (newnode);         // counts nor heights
+
+  mark_dirty (parent);
+
+  node_t::m_count ++;
+  m_batch_edits ++;
+}
+
+// batch_extract(): extract a node during a batch (see
+// begin_batch()). Before extracting it, its ancestors are
+// marked as dirty. After extracting it, the node that takes
+// its place, and the nodes from where extract_node() says
+// the tree might be unbalanced, are marked too. This way,
+// every dirty node hangs from a dirty node (or from the
+// dummy), which is what settle_dirty() relies on. Note that
+// extract_node() only uses counts to choose a substitute,
+// so stale counts are harmless there.
+//
+// Complexity: O(1) amortized over the paths touched in the
+//             batch (O(log N) the first time)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::batch_extract
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  node_t * q, * r, * w;
+  int side;
+
+  AA_ASSERT (p);           // NULL pointer dereference
+
+  AA_ASSERT_EXC (p->m_parent,
+                 invalid_op_with_end()); // Can't extract end()
+
+  q = p->m_parent;
+  side = q->m_children[L]==p ? L : R;
+
+  mark_dirty (q);                 // The way up from p
+
+  r = extract_node (p);           // (from where to update)
+
+  w = q->m_children[side];        // p's substitute, if any
+  if (w)
+    w->m_height = 0;
+
+  mark_dirty (r);                 // Up to p's old place
+
+  node_t::m_count --;
+  m_batch_edits ++;
+}
+
+// mark_dirty(): mark a node and its ancestors as dirty
+// (height 0, which no node has otherwise), climbing until
+// the dummy or until a node that is already dirty (its
+// ancestors are dirty too)
+//
+// Complexity: O(1) amortized over the paths touched in the
+//             batch
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::mark_dirty
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  while (p->m_parent && p->m_height)
+  {
+    p->m_height = 0;
+    p = p->m_parent;
+  }
+}
+
+// settle_dirty(): update and rebalance all the dirty nodes,
+// bottom-up. A dirty node whose children are clean is just
+// updated if it's balanced. Otherwise, it's detached from
+// its children and joined with them again (see
+// join_trees()), which leaves a clean, balanced subtree in
+// its place. No recursion nor stack is needed: the dirty
+// nodes form a tree hanging from the root, and parent
+// links lead back. Finally, the dummy is updated.
+//
+// Complexity: O(D + K log K), where D is the number of dirty
+//             nodes and K the number of edits in the batch
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void avl_array<T,A,bW,W,bP,P,B>::settle_dirty ()
+{
+  node_t * p, * q, * a, * b;
+  size_type i, j;
+  int side;
+
+  p = node_t::m_children[L];
+
+  while (p && p->m_parent &&    // While dirty nodes remain
+         !p->m_height)
+  {
+    a = p->m_children[L];
+    b = p->m_children[R];
+
+    if (a && !a->m_height)      // Go down to a dirty node
+      p = a;                    // with clean children
+    else if (b && !b->m_height)
+      p = b;
+    else
+    {
+      i = balance_key (a);      // (see balance_policy.hpp)
+      j = balance_key (b);
+
+      if (!out_of_balance (i, j) &&   // Balanced: update it
+          !out_of_balance (j, i))     // (a height is a valid
+      {                               // rank for wavl_balance)
+        i = p->left_height ();
+        j = p->right_height ();
+        p->m_height = (i>j?i:j) + 1;
+        update_node (p);
+      }
+      else
+      {
+        q = p->m_parent;
+        side = q->m_children[L]==p ? L : R;
+
+        if (a) a->m_parent = NULL;  // Detach p's subtrees, join
+        if (b) b->m_parent = NULL;  // them again through p, and
+                                    // put the result in p's
+        p = join_trees (a, p, b);   // place
+        q->m_children[side] = p;
+        p->m_parent = q;
+      }
+
+      p = p->m_parent;          // Go on with the parent
+    }
+  }
+
+  update_counters (dummy ());
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
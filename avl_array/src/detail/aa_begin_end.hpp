@@ -42,10 +42,10 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::begin ()
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::begin ()
 {
   return iterator(node_t::m_next);
 }
@@ -56,10 +56,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_iterator
-  avl_array<T,A,bW,W,bP,P>::begin () const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_iterator
+  avl_array<T,A,bW,W,bP,P,B>::begin () const
 {
   return const_iterator(node_t::m_next);
 }
@@ -69,10 +69,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::end ()
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::end ()
 {
   return iterator(dummy());
 }
@@ -84,10 +84,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_iterator
-  avl_array<T,A,bW,W,bP,P>::end () const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_iterator
+  avl_array<T,A,bW,W,bP,P,B>::end () const
 {
   return const_iterator(dummy());
 }
@@ -97,10 +97,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::rbegin ()
+  typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::rbegin ()
 {
   return reverse_iterator(node_t::m_prev);
 }
@@ -111,10 +111,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::rbegin () const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::rbegin () const
 {
   return const_reverse_iterator(node_t::m_prev);
 }
@@ -125,10 +125,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::rend ()
+  typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::rend ()
 {
   return reverse_iterator(dummy());
 }
@@ -139,10 +139,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::rend () const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::rend () const
 {
   return const_reverse_iterator(dummy());
 }
@@ -42,16 +42,16 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(n)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class DP>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::size_type   // # nodes created
-  avl_array<T,A,bW,W,bP,P>::construct_nodes_list
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type // # nodes created
+  avl_array<T,A,bW,W,bP,P,B>::construct_nodes_list
 
-  (typename avl_array<T,A,bW,W,bP,P>::node_t *& first, // 1st/last
-   typename avl_array<T,A,bW,W,bP,P>::node_t *& last,  // of list
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t *& first, // 1st/last
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t *& last,  // of list
 
-   typename avl_array<T,A,bW,W,bP,P>::size_type n, // # to create
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n, // # to create
 
    DP & data_provider,         // Functor whose operator ()
                                // will provide pointers to
@@ -66,6 +66,8 @@ template<class DP>
   node_t * newnode;
   rollback_list_t nodes_list(this);
 
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
   first = last = NULL;    // Start with an empty list
 
   if (!n && !exhaust_dp)  // Zero elements... done
@@ -14,6 +14,7 @@
 
   worth_rebuild(): decide how to perform a massive op. (O(1))
   build_known_size_tree(): make a tree of a given size (O(N))
+  build_subtree(): make a detached subtree of a given size (O(n))
 */
 
 #ifndef _AVL_ARRAY_BUILD_TREE_HPP_
@@ -36,12 +37,12 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::worth_rebuild
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n, // # ins./erase
-   typename avl_array<T,A,bW,W,bP,P>::size_type N, // Current size
+  avl_array<T,A,bW,W,bP,P,B>::worth_rebuild
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n, // # ins./erase
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type N, // Current size
    bool erase)                                     // true=erase,
 {                                                  //   false=ins.
   size_type average_size, final_size, ratio;
@@ -74,7 +75,49 @@ inline
 
 // build_known_size_tree(): build a new tree of a given
 // number of nodes, populating it with existing nodes taken
-// from a list.
+// from a list (see build_subtree()), and link it to the
+// dummy node. With bP, the order labels are spread evenly
+// once the tree is done.
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *   // First unused
+  avl_array<T,A,bW,W,bP,P,B>::build_known_size_tree
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n, // Total #
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * next) // List with
+{                                                    // nodes
+  node_t * p;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
+  init ();  // Fresh start
+
+  if (n<=0)
+    return next;
+
+  p = build_subtree (n, next, dummy ());
+
+  p->m_parent = dummy ();              // Link the whole
+  node_t::m_children[L] = p;           // tree to dummy and
+  node_t::m_count = p->m_count + 1;    // update its count
+  node_t::m_height = p->m_height + 1;  // and height
+
+  if (bW)
+    *node_t::m_total_width = p->total_width ();
+
+  relabel_all ();  // Order labels (with bP)
+
+  return next;  // Return remaining nodes of the list
+}
+
+// build_subtree(): build a subtree of n nodes (n>0), taken
+// from a list (linked by m_next), and return its root, whose
+// m_parent is left NULL. The list pointer (next) is advanced
+// past the nodes used. The nodes are also inserted, in
+// order, in the circular doubly linked list, right after the
+// node last.
 // This takes linear time. That is, proportional to the
 // number of nodes. The tree is directly built in perfect
 // balance, while traversed in-order. Two stack arrays of
@@ -83,17 +126,19 @@ inline
 // construction. No function recursion is used. Can it be
 // more efficient?
 //
-// Complexity: O(N)
+// Complexity: O(n)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::node_t *     // First unused
-  avl_array<T,A,bW,W,bP,P>::build_known_size_tree
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n,   // Total #
-   typename avl_array<T,A,bW,W,bP,P>::node_t * next) // List with
-{                                                    // nodes
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *    // Root
+  avl_array<T,A,bW,W,bP,P,B>::build_subtree
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n,  // Total #
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t *& next, // List with
+                                                      // nodes
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * last)  // Insert
+{                                                     // after it
   size_type depth;     // Current depth
-  node_t * p, * last;  // Current and last nodes
+  node_t * p;          // Current node
 
   size_type                 // Per level: number of nodes
     counts[8*sizeof         // that still have to be created
@@ -107,17 +152,13 @@ template<class T,class A,bool bW,class W,bool bP,class P>
                             //    existing nodes that have to
                             //    be linked to their parent
                             //    (still not created)
-  init ();  // Fresh start
-
-  if (n<=0)
-    return next;
+  AA_ASSERT (n>0);
 
   for (depth=0; depth<8*sizeof(size_type); depth++) // Clear
     nodes[depth] = NULL;                            // stack
 
   counts[0] = n;                     // Nodes to create: n
   depth = 0;
-  last = dummy ();  // The first node will be linked to dummy
 
   for (;;)
   {
@@ -174,17 +215,7 @@ template<class T,class A,bool bW,class W,bool bP,class P>
         p = nodes[depth];      // link the subtrees in the way
 
         if (!depth)            // Back in the top level?
-        {                                      // Finished!
-          p->m_parent = dummy ();              // Link the whole
-          node_t::m_children[L] = p;           // tree to dummy and
-          node_t::m_count = p->m_count + 1;    // update its count
-          node_t::m_height = p->m_height + 1;  // and height
-
-          if (bW)
-            *node_t::m_total_width = p->total_width ();
-
-          return next;  // Return remaining nodes of the list
-        }
+          return p;            // Finished!
 
         depth --;              // Step up
 
@@ -0,0 +1,230 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_compact.hpp
+  ---------------------
+
+  Methods for improving the memory locality of long-lived
+  arrays, whose nodes get scattered in the heap after many
+  insertions and erasures:
+
+  compact_memory(): reallocate all nodes in order (O(N))
+  compact_memory(from,n): idem, n nodes at a time (O(log N+n))
+
+  Private helper methods:
+
+  relocate_nodes(): reallocate n consecutive nodes (O(n))
+  no_remap(): remap functor that does nothing (O(1))
+*/
+
+#ifndef _AVL_ARRAY_COMPACT_HPP_
+#define _AVL_ARRAY_COMPACT_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// compact_memory(): move every element to a new node, and
+// release the old nodes. The new nodes are all requested to
+// the allocator before any old one is released, in the
+// order of the sequence, so that an allocator that serves
+// consecutive requests from consecutive addresses (a fresh
+// heap region, a pool, or a monotonic buffer) will place
+// neighbours together, and iterating will touch memory
+// sequentially. The shape of the tree, the widths and the
+// order don't change. Every iterator (except end()) is
+// invalidated; remap (if given) is called as remap(old,new)
+// for every element, where old is the const_iterator that
+// referred it before (which can only be compared, not
+// dereferenced nor moved) and new is the iterator that
+// refers it now. If allocating or copying throws, nothing
+// changes. Note that the old and the new nodes coexist for
+// a while, so the peak memory usage is twice the usual.
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::compact_memory ()
+{
+  relocate_nodes (node_t::m_next, size (), no_remap);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class F>
+inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::compact_memory (F remap)
+{
+  relocate_nodes (node_t::m_next, size (), remap);
+}
+
+// compact_memory(): incremental version of the above, for
+// spreading the work in time. Only (up to) n elements are
+// moved, starting at the position from, and the position
+// where the next call should start is returned (size()
+// means that the whole array has been done). Only the
+// iterators referring the moved elements are invalidated
+// (and passed to remap, if given). The peak memory usage
+// is only n nodes more than the usual. The array can be
+// modified between two calls.
+//
+// Complexity: O(log N + n)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::compact_memory
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
+{
+  return compact_memory (from, n, no_remap);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class F>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::compact_memory
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   F remap)
+{
+  AA_ASSERT_EXC (from<=size (), index_out_of_bounds());
+
+  if (n > size () - from)
+    n = size () - from;
+
+  if (n)
+    relocate_nodes (node_at_pos (from), n, remap);
+
+  return from + n;
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// relocate_nodes(): move the n nodes starting at p to new
+// nodes, and return the node that follows them. First, all
+// the new nodes are created (copying the elements), linked
+// by their m_next fields; if something throws here, they are
+// destroyed and nothing has changed. Then, every new node
+// takes the place of its old one in the tree and in the
+// list: it gets all its fields, and the pointers of the
+// parent, children and neighbours are redirected to it. The
+// old nodes are not modified at all by this (only their
+// relatives are), so they can still be traversed through
+// m_next, and finally released.
+//
+// Complexity: O(n)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class F>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::relocate_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   F remap)
+{
+  node_t * first, * last, * old, * q, * parent;
+  size_type i;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
+  first = last = NULL;
+
+  try
+  {
+    for (i=0, old=p; i<n; i++, old=old->m_next)
+    {
+      AA_ASSERT (old->m_parent);        // Never the dummy
+
+      q = new_node (&data (old));       // Copy, in order
+      q->m_next = NULL;
+
+      if (last)
+        last->m_next = q;
+      else
+        first = q;
+
+      last = q;
+    }
+  }
+  catch (...)
+  {
+    while (first)                       // Undo and propagate
+    {
+      q = first;
+      first = first->m_next;
+      delete_node (q);
+    }
+
+    throw;
+  }
+
+  for (i=0, old=p, q=first; i<n; i++)   // Nothing throws
+  {                                     // from here
+    last = q->m_next;                   // (next new node)
+    *q = *old;                          // All tree fields
+
+    parent = q->m_parent;
+    parent->m_children[parent->m_children[L]==old ? L : R] = q;
+
+    if (q->m_children[L]) q->m_children[L]->m_parent = q;
+    if (q->m_children[R]) q->m_children[R]->m_parent = q;
+
+    q->m_prev->m_next = q;
+    q->m_next->m_prev = q;
+
+    old = old->m_next;                  // (still the old one)
+    q = last;
+  }
+
+  for (i=0, old=p, q=first; i<n; i++)
+  {
+    remap (make_const_iterator (old), iterator(q));
+
+    last = old;
+    old = old->m_next;
+    delete_node (last);
+    q = q->m_next;
+  }
+
+  return q;
+}
+
+// no_remap(): do nothing (remap functor for the versions
+// of compact_memory() that don't take one)
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::no_remap
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_iterator,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator)
+{
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -46,11 +46,11 @@ namespace mkr  // Public namespace
 // (where N is the number of T objects in the smaller
 // avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline  MKR: should I make inline at least the 1st part?
   bool
-  avl_array<T,A,bW,W,bP,P>::operator==
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)   const
+  avl_array<T,A,bW,W,bP,P,B>::operator==
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a) const
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< EqualityComparableConcept<value_type> >();
@@ -73,11 +73,11 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 // (where N is the number of T objects in the smaller
 // avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::operator!=
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)   const
+  avl_array<T,A,bW,W,bP,P,B>::operator!=
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a) const
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< EqualityComparableConcept<value_type> >();
@@ -97,11 +97,11 @@ inline
 // (where N is the number of T objects in the smaller
 // avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline  MKR: should I make inline at least the 1st part?
   bool
-  avl_array<T,A,bW,W,bP,P>::operator<
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)   const
+  avl_array<T,A,bW,W,bP,P,B>::operator<
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a) const
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -126,11 +126,11 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 // (where N is the number of T objects in the smaller
 // avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::operator>
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)   const
+  avl_array<T,A,bW,W,bP,P,B>::operator>
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a) const
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -145,11 +145,11 @@ inline
 // (where N is the number of T objects in the smaller
 // avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::operator<=
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)   const
+  avl_array<T,A,bW,W,bP,P,B>::operator<=
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a) const
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -164,11 +164,11 @@ inline
 // (where N is the number of T objects in the smaller
 // avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::operator>=
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)   const
+  avl_array<T,A,bW,W,bP,P,B>::operator>=
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a) const
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
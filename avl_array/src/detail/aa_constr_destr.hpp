@@ -13,7 +13,10 @@
   Constructors and destructor:
 
   Default con.: empty avl_array (O(1))
+  Allocator con.: empty avl_array using al (O(1))
   Copy con.: copy of other avl_array (O(N))
+  Copy con. with allocator: idem, using al (O(N))
+  Move con.: steal the contents of other avl_array (O(1))
   Vector con.: avl_array with n elements like t (O(N))
   Vector def. con.: " with n default-constructed elem. (O(N))
   Sequence con.: " with copies of [from,to) (O(N))
@@ -43,9 +46,26 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array ()
+  avl_array<T,A,bW,W,bP,P,B>::avl_array ()
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
+{
+  init ();
+}
+
+// Allocator constructor: create an empty avl_array that
+// will allocate its nodes with (a rebound copy of) al
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  avl_array<T,A,bW,W,bP,P,B>::avl_array (const A & al)
+  : allocator(al),
+    m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
   init ();
 }
@@ -53,14 +73,21 @@ inline
 // Copy constructor: create an avl_array copying the
 // contents of a. The T objects will be copied one by
 // one, in sequence order, using the T copy constructor.
-// The resulting tree will be perfectly balanced.
+// The resulting tree will be perfectly balanced. The
+// allocator is the one that a's allocator selects for
+// copies (with C++11; a default constructed one with
+// C++98). Note that an std::pmr allocator selects the
+// default memory resource, not a's one.
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array
-  (const typename avl_array<T,A,bW,W,bP,P>::my_class & a)
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a)
+  : allocator(alloc_traits_t::select_on_copy (a.allocator)),
+    m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
   node_t * first, * last;
   iter_aa_data_provider<const_pointer,
@@ -70,6 +97,51 @@ inline
   build_known_size_tree (a.size(), first);
 }
 
+// Copy constructor with allocator: same as above, but
+// allocating the new nodes with (a rebound copy of) al
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a,
+   const A & al)
+  : allocator(al),
+    m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
+{
+  node_t * first, * last;
+  iter_aa_data_provider<const_pointer,
+                        const_iterator, bW, W> dp(a.begin());
+
+  construct_nodes_list (first, last, a.size(), dp);
+  build_known_size_tree (a.size(), first);
+}
+
+#ifdef AA_CXX11
+
+// Move constructor: create an avl_array with the contents,
+// the allocator and the arena mode of a, and leave a empty.
+// No T object is touched, and all iterators referring
+// elements of a will refer the same elements in *this
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
+  (typename avl_array<T,A,bW,W,bP,P,B>::my_class && a) noexcept
+  : allocator(std::move (a.allocator)),
+    m_arena(a.m_arena),
+    m_in_batch(false), m_batch_edits(0)
+{
+  init ();
+  steal_contents (a);
+}
+
+#endif
+
 // Vector constructor: create an avl_array with n
 // elements, all them copies of t. The T objects will be
 // created one by one using the T copy constructor. Three
@@ -78,11 +150,13 @@ inline
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
   node_t * first, * last;
   copy_data_provider<const_pointer> dp(&t);
@@ -91,11 +165,13 @@ inline
   build_known_size_tree (n, first);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
   (int n,
-   typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
   node_t * first, * last;
   copy_data_provider<const_pointer> dp(&t);
@@ -105,11 +181,13 @@ inline
   build_known_size_tree (n, first);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
   (long n,
-   typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
   node_t * first, * last;
   copy_data_provider<const_pointer> dp(&t);
@@ -125,10 +203,12 @@ inline
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
   node_t * first, * last;
   null_data_provider<const_pointer> dp;
@@ -144,10 +224,12 @@ inline
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template <class IT>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array (IT from, IT to)
+  avl_array<T,A,bW,W,bP,P,B>::avl_array (IT from, IT to)
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< InputIteratorConcept<IT> >();
@@ -167,12 +249,14 @@ inline
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template <class IT>
 inline
-  avl_array<T,A,bW,W,bP,P>::avl_array
+  avl_array<T,A,bW,W,bP,P,B>::avl_array
   (IT from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n)
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
+  : m_arena(false),
+    m_in_batch(false), m_batch_edits(0)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< InputIteratorConcept<IT> >();
@@ -187,11 +271,11 @@ inline
 
 // Destructor: deallocate contents
 //
-// Complexity: O(N)
+// Complexity: O(N) (O(1) in arena mode, see clear())
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array<T,A,bW,W,bP,P>::~avl_array ()
+  avl_array<T,A,bW,W,bP,P,B>::~avl_array ()
 {
   clear ();  // (See impl. of clear() in erase.hpp)
 }
@@ -203,9 +287,9 @@ inline
 // corresponding to an "empty" state (O(1), regarded that W's
 // constructor is O(1) ;)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array<T,A,bW,W,bP,P>::init ()
+  avl_array<T,A,bW,W,bP,P,B>::init ()
 {
   node_t::m_parent =
   node_t::m_children[0] =
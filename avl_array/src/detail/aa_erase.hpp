@@ -13,18 +13,18 @@
   Methods for erasing elements:
 
   it/rit erase(it/rit): (O(log N))
-  it erase(it,n): vector-erase (O(min{N, n log N}))
-  rit erase(rit,n): vector-erase (reverse) (O(min{N, n log N}))
-  it erase(from,to): range-erase (O(min{N, n log N}))
-  rit erase(rfrom,rto): range-erase (reverse) (O(min{N, n log N}))
-  clear(): delete all (O(N))
+  it erase(it,n): vector-erase (O(n + log N))
+  rit erase(rit,n): vector-erase (reverse) (O(n + log N))
+  it erase(from,to): range-erase (O(n + log N))
+  rit erase(rfrom,rto): range-erase (reverse) (O(n + log N))
+  clear(): delete all (O(N), or O(1) in arena mode)
 
   Private helper methods:
 
   extract_node(): remove a node (O(1)) [+ later rebalance]
   erase_it(IT): delete one element (O(log N))
-  extract_nodes(): remove n nodes (O(min{N, n log N})
-  erase_it(IT,n): delete n elements (O(min{N, n log N})
+  extract_nodes(): remove n nodes (O(n + log N))
+  erase_it(IT,n): delete n elements (O(n + log N))
 */
 
 #ifndef _AVL_ARRAY_ERASE_HPP_
@@ -45,20 +45,20 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::erase
-  (typename avl_array<T,A,bW,W,bP,P>::iterator it)
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::erase
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator it)
 {
   return erase_it (it);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::erase
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it)
+  typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::erase
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it)
 {
   return erase_it (it);
 }
@@ -66,24 +66,24 @@ inline
 // Vector erase: remove a given number of elements from the
 // array (and delete them) starting at a given position
 //
-// Complexity: O(min{N, n log N})
+// Complexity: O(n + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::erase
-  (typename avl_array<T,A,bW,W,bP,P>::iterator from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n)
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::erase
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
 {
   return erase_it (from, n); // Just call private templ. method
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::erase
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n)
+  typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::erase
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
 {
   return erase_it (from, n); // Just call private templ. method
 }
@@ -91,14 +91,14 @@ inline
 // Range erase: remove a given range of elements from the
 // array (and delete them)
 //
-// Complexity: O(min{N, n log N})
+// Complexity: O(n + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::erase
-  (typename avl_array<T,A,bW,W,bP,P>::iterator from,
-   typename avl_array<T,A,bW,W,bP,P>::iterator to)
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::erase
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator from,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator to)
 {
   AA_ASSERT_HO (owner(from.ptr)==this); // from and to must point
   AA_ASSERT_HO (owner(to.ptr)==this);   // into this array
@@ -106,12 +106,12 @@ inline
   return erase_it (from, to-from); // Get the difference and use
 }                                  // vector erase
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::erase
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator from,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator to)
+  typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::erase
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator from,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator to)
 {
   AA_ASSERT_HO (owner(from.ptr)==this); // from and to must point
   AA_ASSERT_HO (owner(to.ptr)==this);   // into this array
@@ -120,15 +120,23 @@ inline
 }                                  // vector erase
 
 // clear(): delete all the contents of the array, leaving
-// it empty
+// it empty. In arena mode (see set_arena_mode()), if nodes
+// are trivially destructible, they are just forgotten: the
+// arena allocator will release their memory at once.
 //
-// Complexity: O(N)
+// Complexity: O(N) (O(1) in arena mode)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
-void avl_array<T,A,bW,W,bP,P>::clear ()
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+void avl_array<T,A,bW,W,bP,P,B>::clear ()
 {
   node_t * p, * q;
 
+  if (m_arena && trivially_destructible<payload_node_t>::value)
+  {
+    init ();           // Forget everything; the memory
+    return;            // belongs to the arena
+  }
+
   node_t::m_prev->m_next = NULL;
   p = node_t::m_next;
 
@@ -152,11 +160,11 @@ void avl_array<T,A,bW,W,bP,P>::clear ()
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::extract_node
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::extract_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   node_t * q, * r, * w;
   size_type cl, cr;
@@ -207,6 +215,8 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 
     w->m_children[1-side] = p->m_children[1-side];
     w->m_children[1-side]->m_parent = w;
+
+    w->m_height = p->m_height;  // (a rank, with wavl_balance)
   }
   else           // Well, no subtree is empty and both inner
   {              // places two levels under the victim are
@@ -240,6 +250,8 @@ template<class T,class A,bool bW,class W,bool bP,class P>
       q->m_children[L] = w;
     else
       q->m_children[R] = w;
+
+    w->m_height = p->m_height;  // (a rank, with wavl_balance)
   }
 
   p->m_next->m_prev = p->m_prev;  // Bypass the victim in the
@@ -254,10 +266,10 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class IT>
 inline
-  IT avl_array<T,A,bW,W,bP,P>::erase_it (IT it)
+  IT avl_array<T,A,bW,W,bP,P,B>::erase_it (IT it)
 {
 #ifdef BOOST_CLASS_REQUIRE
 #ifdef AA_USE_RANDOM_ACCESS_TAG
@@ -276,8 +288,15 @@ inline
 
   p = it.ptr;
   ++ it;
-  r = extract_node (p);
-  update_counters_and_rebalance (r);
+
+  if (m_in_batch)                 // Deferred rebalancing
+    batch_extract (p);            // (see aa_batch.hpp)
+  else
+  {
+    r = extract_node (p);
+    update_counters_and_rebalance (r);
+  }
+
   delete_node (p);
 
   return it;
@@ -288,33 +307,30 @@ inline
 // position. The sublist of extracted elements is returned
 // via first and last (pointers passed by ref.). The
 // parameter reverse indicates how to build the list.
+// A few nodes are extracted one by one. Otherwise, they
+// are only unlinked from the list, and then the whole
+// range is cut out of the tree with cut_nodes(), which
+// doesn't touch the rest of the tree
 //
-// Complexity: (O(min{N, n log N})
+// Complexity: O(n + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template <class IT>
 //not inline                              // Return true iff dst
   bool                                    // belongs to the
-  avl_array<T,A,bW,W,bP,P>::extract_nodes // extracted range
+  avl_array<T,A,bW,W,bP,P,B>::extract_nodes // extracted range
 
   (IT & from,                                 // Source pos.
    typename avl_array<T,A,bW,W,
-                          bP,P>::size_type n,     // # nodes
+                          bP,P,B>::size_type n,     // # nodes
                                                   // to extract
    typename avl_array<T,A,bW,W,
-                          bP,P>::node_t *& first, // List with
+                          bP,P,B>::node_t *& first, // List with
    typename avl_array<T,A,bW,W,                   // extracted
-                          bP,P>::node_t *& last,  // nodes
+                          bP,P,B>::node_t *& last,  // nodes
 
    typename avl_array<T,A,bW,W,
-                          bP,P>::node_t * dst, // Dest. to check
-
-   bool * delayed_rebuild,  // In: non-NULL means "delay tree
-                            // reconstruction, cause the same tree
-                            // is used for destination"
-                            // Out: true means "reconstruction was
-                            // delayed and the caller should do it
-                            // after reinsertion"
+                          bP,P,B>::node_t * dst, // Dest. to check
 
    bool reverse) // true means: "destination has been secified with
                  // a reverse iterator, so build a reverse list"
@@ -330,16 +346,19 @@ template <class IT>
 #endif
 
   node_t * p, * r;
-  size_type i;
+  size_type i, pos, end;
+  my_class * a;
   bool dst_extracted;
 
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
   first = last = NULL;
   if (n==0) return false;
 
   dst_extracted = false;
 
-  if (!worth_rebuild(n,size(),true))  // If there are 'few'
-  {                                   // elements to extract
+  if (n<=2)                               // If there are 'few'
+  {                                       // elements to extract
     first = last = p = from.ptr;
                                          // Be careful:
     for (i=0; i<n && p->m_parent; i++)   // from can be a
@@ -371,11 +390,14 @@ template <class IT>
   else             // If there are 'many' elements to extract
   {
     first = last = p = from.ptr;
+    pos = 0;
                                          // Be careful:
     for (i=0; i<n && p->m_parent; i++)   // from can be a
     {                                    // REVERSE iterator!
                                          // (use its ++ optor.)
                                          // and don't extract end
+      if (i==0)
+        pos = position_of_node (p, a, false);
 
       if (p==dst)                        // Detect src-dest
         dst_extracted = true;            // overlapping
@@ -383,8 +405,8 @@ template <class IT>
                                          // Just extract them
       ++ from;                           // from the circular
       p->m_next->m_prev = p->m_prev;     // doubly linked list
-      p->m_prev->m_next = p->m_next;     // and reorganize the
-                                         // whole tree later
+      p->m_prev->m_next = p->m_next;     // (the tree is still
+                                         // untouched)
       if (reverse)
       {                                  // Build the list
         p->m_next = first;               // according to the
@@ -399,13 +421,15 @@ template <class IT>
       p = from.ptr;      // performed prior to extraction
     }
 
-    if (delayed_rebuild)         // The tree is broken now, so
-    {                            // rebuild it, or indicate
-      *delayed_rebuild = true;   // delayed rebuild and adjust
-      node_t::m_count -= n;      // the size for it
+    if (i)                         // Now cut them out of the
+    {                              // tree. The range starts
+      end = position_of_node       // at the first node taken
+              (reverse ? first :   // or at the last one (if
+                         last,     // from is a reverse
+               a, false);          // iterator)
+
+      cut_nodes (pos<end ? pos : end, i);
     }
-    else
-      build_known_size_tree (size()-n, node_t::m_next);
   }
 
   first->m_prev = NULL;    // Isolate the extracted nodes
@@ -419,17 +443,17 @@ template <class IT>
     // this method was public, it might be called with const
     // iterators (wrong). That's why it is private.
     //
-    // Complexity: n<N/2 ? O(n*log(N)) : O(N)
+    // Complexity: O(n + log N)
     // (where N is the number of elements in the array and n is
     // the number of elements to erase)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template <class IT>
 //not inline
   IT
-  avl_array<T,A,bW,W,bP,P>::erase_it
+  avl_array<T,A,bW,W,bP,P,B>::erase_it
   (IT from,                                        // Start pos.
-   typename avl_array<T,A,bW,W,bP,P>::size_type n) // # to erase
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n) // # to erase
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< InputIteratorConcept<IT> >();
@@ -40,10 +40,10 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reference
-  avl_array<T,A,bW,W,bP,P>::front ()
+  typename avl_array<T,A,bW,W,bP,P,B>::reference
+  avl_array<T,A,bW,W,bP,P,B>::front ()
 {
   return *begin();
 }
@@ -53,10 +53,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reference
-  avl_array<T,A,bW,W,bP,P>::front ()                   const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reference
+  avl_array<T,A,bW,W,bP,P,B>::front ()                 const
 {
   return *begin();
 }
@@ -65,11 +65,11 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::push_front
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+  avl_array<T,A,bW,W,bP,P,B>::push_front
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
 {
   insert (begin(), t);
 }
@@ -79,10 +79,10 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::pop_front ()
+  avl_array<T,A,bW,W,bP,P,B>::pop_front ()
 {
   erase (begin());
 }
@@ -91,10 +91,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reference
-  avl_array<T,A,bW,W,bP,P>::back ()
+  typename avl_array<T,A,bW,W,bP,P,B>::reference
+  avl_array<T,A,bW,W,bP,P,B>::back ()
 {
   return *--end();
 }
@@ -104,10 +104,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reference
-  avl_array<T,A,bW,W,bP,P>::back ()                    const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reference
+  avl_array<T,A,bW,W,bP,P,B>::back ()                  const
 {
   return *--end();
 }
@@ -116,11 +116,11 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::push_back
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+  avl_array<T,A,bW,W,bP,P,B>::push_back
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
 {
   insert (end(), t);
 }
@@ -130,9 +130,9 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  void avl_array<T,A,bW,W,bP,P>::pop_back ()
+  void avl_array<T,A,bW,W,bP,P,B>::pop_back ()
 {
   erase (--end());
 }
@@ -15,7 +15,7 @@
   it insert(t): insert anywhere (O(log N) with no rotations)
   it insert(it,t): insert before (O(log N))
   rit insert(rit,t): insert before* (O(log N))
-  insert(it,n,t): vector-insert before (O(min{N, n log N}))
+  insert(it,n,t): vector-insert before (O(n + log N))
   insert(rit,n,t): vector-insert before**        "
   insert(it,from,to): sequence-insert before     "
   insert(rit,from,to): sequence-insert before**  "
@@ -25,6 +25,7 @@
   Private helper methods:
 
   insert_before(): insert a node in a given pos. (O(log N))
+  link_before(): link a node in a given pos., no update (O(1))
   insert_anywhere(): add a node to the tree (O(log N))
 */
 
@@ -58,11 +59,11 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator     // Insert anywhere
-  avl_array<T,A,bW,W,bP,P>::insert
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t) // Original
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator   // Insert anywhere
+  avl_array<T,A,bW,W,bP,P,B>::insert
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t) // Original
 {
   node_t * newnode;
 
@@ -77,19 +78,24 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::insert
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename avl_array<T,A,bW,W,
-                                bP,P>::iterator & it, // Where
+                                bP,P,B>::iterator & it, // Where
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)   // Original
+                          bP,P,B>::const_reference t)   // Original
 {
   node_t * newnode;
 
   newnode = new_node (&t);
-  insert_before (newnode, it.ptr);
+
+  if (m_in_batch)                 // Deferred rebalancing
+    batch_insert (newnode, it.ptr);  // (see aa_batch.hpp)
+  else
+    insert_before (newnode, it.ptr);
+
   return iterator(newnode);
 }
 
@@ -101,20 +107,25 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::insert
+  typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename
      avl_array<T,A,bW,W,                             // Where and
-                   bP,P>::reverse_iterator & it,     // how (REV.)
+                   bP,P,B>::reverse_iterator & it,     // how (REV.)
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)  // Original
+                          bP,P,B>::const_reference t)  // Original
 {
   node_t * newnode;
 
   newnode = new_node (&t);
-  insert_before (newnode, it.ptr->m_next);
+
+  if (m_in_batch)                 // Deferred rebalancing
+    batch_insert (newnode, it.ptr->m_next);
+  else
+    insert_before (newnode, it.ptr->m_next);
+
   return reverse_iterator(newnode);
 }
 
@@ -122,20 +133,20 @@ inline
 // previous insert operations, several versions are
 // provided (signed/unsigned, normal/reverse)
 //
-// Complexity: O(min{N, n log N})
+// Complexity: O(n + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename avl_array<T,A,bW,W,
-                                bP,P>::iterator it,  // Where
+                                bP,P,B>::iterator it,  // Where
    typename avl_array<T,A,bW,W,
-                          bP,P>::size_type n,        // How many
+                          bP,P,B>::size_type n,        // How many
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)  // Original
+                          bP,P,B>::const_reference t)  // Original
 {
-  node_t * p, * next, * first, * last;
+  node_t * p, * first, * last;
   copy_data_provider<const_pointer> dp(&t);
 
   p = it.ptr;
@@ -146,66 +157,53 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 
   construct_nodes_list (first, last, n, dp);
 
-  if (!worth_rebuild(n,size()))   // If there are 'few'
-  {                               // elements to insert
-    do
-    {                                 // Repeat n times:
-      next = first;                   // Insert before it
-      first = first->m_next;          // (after previously
-      insert_before (next, p);        // inserted copies)
-    }
-    while (first);
-  }
-  else            // If there are 'many' elements to insert
-  {
-    last->m_next = p;
-    p->m_prev->m_next = first;
-
-    build_known_size_tree (n+size(), node_t::m_next);
-  }
-}
+  if (n==1)                       // Just one: insert it
+    insert_before (first, p);
+  else                            // Otherwise, build them
+    link_nodes_before (first, n, p);  // into a subtree and
+}                                     // join it at p
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename avl_array<T,A,bW,W,
-                                bP,P>::iterator & it, // Where
+                                bP,P,B>::iterator & it, // Where
    int n,                                             // How many
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)   // Original
+                          bP,P,B>::const_reference t)   // Original
 {
   AA_ASSERT (n>=0);  // Can't insert a negative amount
 
   insert (it, size_type(n>0?n:0), t);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename avl_array<T,A,bW,W,
-                                bP,P>::iterator & it, // Where
+                                bP,P,B>::iterator & it, // Where
    long n,                                            // How many
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)   // Original
+                          bP,P,B>::const_reference t)   // Original
 {
   AA_ASSERT (n>=0);  // Can't insert a negative amount
 
   insert (it, size_type(n>0?n:0), t);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename
      avl_array<T,A,bW,W,                             // Where and
-                   bP,P>::reverse_iterator it,       // how (REV.)
+                   bP,P,B>::reverse_iterator it,       // how (REV.)
    typename avl_array<T,A,bW,W,
-                          bP,P>::size_type n,        // How many
+                          bP,P,B>::size_type n,        // How many
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)  // Original
+                          bP,P,B>::const_reference t)  // Original
 {
   node_t * first, * last, * p;
   copy_data_provider<const_pointer> dp(&t);
@@ -216,53 +214,40 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 
   construct_nodes_list (first, last, n, dp, true);
 
-  if (!worth_rebuild(n,size()))   // 'few' elements to insert
-  {
-    do                         // Insert them one by one after
-    {                          // it (every node goes before
-      p = first;               // the previously inserted one)
-      first = first->m_next;
-      insert_before (p, it.ptr->m_next);
-    }
-    while (first);
-  }
-  else            // If there are 'many' elements to insert
-  {
-                                     // Insert them only in the
-    last->m_next = it.ptr->m_next;   // circular doubly linked
-    it.ptr->m_next = first;          // list, and then
-                                     // rebuild the tree
-
-    build_known_size_tree (n+size(), node_t::m_next);
-  }
+  p = it.ptr->m_next;             // The list is reversed, and
+                                  // goes after it (straight
+  if (n==1)                       // POV)
+    insert_before (first, p);
+  else
+    link_nodes_before (first, n, p);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename
      avl_array<T,A,bW,W,                             // Where and
-                   bP,P>::reverse_iterator & it,     // how (REV.)
+                   bP,P,B>::reverse_iterator & it,     // how (REV.)
    int n,                                            // How many
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)  // Original
+                          bP,P,B>::const_reference t)  // Original
 {
   AA_ASSERT (n>=0);  // Can't insert a negative amount
 
   insert (it, size_type(n>0?n:0), t);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
+  avl_array<T,A,bW,W,bP,P,B>::insert
   (const typename
      avl_array<T,A,bW,W,                             // Where and
-                   bP,P>::reverse_iterator & it,     // how (REV.)
+                   bP,P,B>::reverse_iterator & it,     // how (REV.)
    long n,                                           // How many
    typename avl_array<T,A,bW,W,
-                          bP,P>::const_reference t)  // Original
+                          bP,P,B>::const_reference t)  // Original
 {
   AA_ASSERT (n>=0);  // Can't insert a negative amount
 
@@ -272,14 +257,14 @@ inline
 // Sequence insert: insert a copy of the given sequence
 // [from,to) before a given position it
 //
-// Complexity: O(min{N, n log N})
+// Complexity: O(n + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template <class IT>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
-  (typename avl_array<T,A,bW,W,bP,P>::iterator it,    // Where
+  avl_array<T,A,bW,W,bP,P,B>::insert
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator it,  // Where
    IT from,
    IT to)                // Originals (*to not included)
 {
@@ -287,7 +272,7 @@ template <class IT>
   function_requires< InputIteratorConcept<IT> >();
 #endif
 
-  node_t * first, * last, * p;
+  node_t * first, * last;
   range_data_provider<const_pointer,IT> dp(from,to);
   size_type n;
                                       // it must point
@@ -298,33 +283,18 @@ template <class IT>
 
   n = construct_nodes_list (first, last, 0, dp, false, true);
 
-  if (!worth_rebuild(n,size()))   // 'few' elements to insert
-  {
-    do
-    {
-      p = first;                  // Insert them one by one
-      first = first->m_next;      // before it (every one
-      insert_before (p, it.ptr);  // goes after the previously
-    }                             // inserted)
-    while (first);
-  }
-  else            // If there are 'many' elements to insert
-  {
-                                     // Insert them only in the
-    last->m_next = it.ptr;           // circular doubly linked
-    it.ptr->m_prev->m_next = first;  // list, and then
-                                     // rebuild the tree
+  if (n==1)                       // Just one: insert it
+    insert_before (first, it.ptr);
+  else                            // Otherwise, build them
+    link_nodes_before (first, n, it.ptr);  // into a subtree
+}                                          // and join it
 
-    build_known_size_tree (n+size(), node_t::m_next);
-  }
-}
-
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template <class IT>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it, // Where
+  avl_array<T,A,bW,W,bP,P,B>::insert
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it, // Where
    IT from,
    IT to)                     // Originals (*to not included)
 {
@@ -343,25 +313,12 @@ template <class IT>
 
   n = construct_nodes_list (first, last, 0, dp, true, true);
 
-  if (!worth_rebuild(n,size()))   // 'few' elements to insert
-  {
-    do                         // Insert them one by one after
-    {                          // it (every node goes before
-      p = first;               // the previously inserted one)
-      first = first->m_next;
-      insert_before (p, it.ptr->m_next);
-    }
-    while (first);
-  }
-  else            // If there are 'many' elements to insert
-  {
-                                     // Insert them only in the
-    last->m_next = it.ptr->m_next;   // circular doubly linked
-    it.ptr->m_next = first;          // list, and then
-                                     // rebuild the tree
-
-    build_known_size_tree (n+size(), node_t::m_next);
-  }
+  p = it.ptr->m_next;             // The list is reversed, and
+                                  // goes after it (straight
+  if (n==1)                       // POV)
+    insert_before (first, p);
+  else
+    link_nodes_before (first, n, p);
 }
 
 
@@ -374,16 +331,43 @@ template <class IT>
 // updates. Therefore, this operation takes log(N) time,
 // where N is the number of nodes in the tree. When the
 // given position is the dummy node, the new node is
-// appended at the end of the sequence.
+// appended at the end of the sequence. With bP, the new
+// node gets an order label too, unless label is false (for
+// callers that will relabel everything afterwards).
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
-//not inline
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
   void
-  avl_array<T,A,bW,W,bP,P>::insert_before
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * newnode,
-   typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  avl_array<T,A,bW,W,bP,P,B>::insert_before
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * newnode,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   bool label)
+{
+  node_t * parent;       // Parent of the new node
+
+  parent = link_before (newnode, p);
+
+  if (bP && label)                    // Order label (see
+    label_node (newnode);             // detail/aa_order.hpp)
+
+  update_counters_and_rebalance (parent); // Travel to the root
+}                                         // assuring balance
+
+// link_before(): link a given node as a leaf of the tree, in
+// a given position (like insert_before(), but neither
+// labelling it nor updating anything above it). Return
+// the new node's parent.
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::link_before
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * newnode,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   node_t * parent;       // Future parent of the new node
   int side;              // Side (of the parent) where the
@@ -412,8 +396,8 @@ template<class T,class A,bool bW,class W,bool bP,class P>
   parent->m_children[side] = newnode; // its new parent with
   newnode->m_parent = parent;         // each other
 
-  update_counters_and_rebalance (parent); // Travel to the root
-}                                         // assuring balance
+  return parent;
+}
 
 // insert_anywhere(): add a node to the tree. The position
 // doesn't matter, so choose the best place to keep the
@@ -431,14 +415,15 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N)  (no rotations!)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::insert_anywhere
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * newnode)
+  avl_array<T,A,bW,W,bP,P,B>::insert_anywhere
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * newnode)
 {
   node_t * p;   // Future parent of the new node
 
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
   AA_ASSERT (newnode);     // Can't insert NULL
 
   if (!node_t::m_children[L])   // If the tree is empty, use the
@@ -476,8 +461,14 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 
   newnode->m_parent = p;           // Link to the parent
 
-  update_counters (p);     // Travel to the root updating
-}                          // counts and heights
+  if (bP)                          // Order label (see
+    label_node (newnode);          // detail/aa_order.hpp)
+
+  if (B::scheme==avl_scheme)
+    update_counters (p);     // Travel to the root updating
+  else                       // counts and heights (other
+    update_counters_and_rebalance (p);  // balancing policies
+}                                       // might need rotations)
 
 //////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_intrusive.hpp
+  -----------------------
+
+  Private helper methods for intrusive_avl_array (see
+  detail/intrusive_avl_array.hpp), whose nodes are not allocated
+  nor deleted, but linked and unlinked:
+
+  link_node(): insert an unlinked node (O(log N))
+  unlink_node(): take a node out, leaving it unlinked (O(log N))
+  unlink_all(): take all nodes out, leaving them unlinked (O(N))
+  iterator_of(): get an iterator referring a node (O(1))
+*/
+
+#ifndef _AVL_ARRAY_INTRUSIVE_HPP_
+#define _AVL_ARRAY_INTRUSIVE_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// link_node(): insert the node n, which must not be linked
+// in any tree, before the position it, and return an
+// iterator referring it. If n is linked (its parent is not
+// NULL), throw hook_already_linked. The node width (NPSV) is
+// kept.
+//
+// Complexity: O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::link_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * n,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator it)
+{
+  AA_ASSERT (n);                      // NULL pointer dereference
+  AA_ASSERT (it.ptr);                 // it must point somewhere
+  AA_ASSERT_HO (owner(it.ptr)==this); // it must point here
+
+  AA_ASSERT_EXC (!n->m_parent,
+                 hook_already_linked()); // In some tree yet
+
+  n->init_tree_fields ();   // Leaf with no relatives
+  insert_before (n, it.ptr);
+  return iterator(n);
+}
+
+// unlink_node(): take the node referred by it out of the
+// tree, rebalance, and leave the node unlinked (with a NULL
+// parent, so that it can be linked again). Return an
+// iterator referring the next node.
+//
+// Complexity: O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::unlink_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator it)
+{
+  node_t * p, * next;
+
+  p = it.ptr;
+  AA_ASSERT (p);                      // it must point somewhere
+  AA_ASSERT_HO (owner(p)==this);      // it must point here
+
+  AA_ASSERT_EXC (p->m_parent,
+                 invalid_op_with_end());  // Can't unlink end()
+
+  next = p->m_next;
+  update_counters_and_rebalance (extract_node (p));
+  p->init_tree_fields ();             // Unlinked now
+  return iterator(next);
+}
+
+// unlink_all(): leave the array empty, and every node that
+// was in it unlinked
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::unlink_all ()
+{
+  node_t * p, * q;
+
+  node_t::m_prev->m_next = NULL;
+  p = node_t::m_next;
+
+  init ();                 // Reset
+
+  while (p)
+  {
+    q = p;                 // Traverse the list, unlinking
+    p = p->m_next;         // every node (but not destroying
+    q->init_tree_fields ();   // them; they are not ours)
+  }
+}
+
+// iterator_of(): return an iterator referring the node p
+// (which must be linked in some tree)
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::iterator_of
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  AA_ASSERT (p);             // NULL pointer dereference
+  AA_ASSERT (p->m_parent);   // Not linked: no iterator
+  return iterator(p);
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,469 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_join_split.hpp
+  ------------------------
+
+  Private helper methods for joining and splitting trees. They
+  work on detached subtrees (whose root's m_parent is NULL),
+  and don't touch the circular doubly linked list:
+
+  join_trees(): join two subtrees and a node in the middle
+                                              (O(|h1-h2|+1))
+  split_tree(): split a subtree in two at a position (O(log N))
+
+  Private helper methods for buffered_avl_array, built on the
+  above ones:
+
+  append_nodes(): add n nodes at one end (O(n + log N))
+  detach_nodes(): take out n nodes from one end (O(n + log N))
+
+  Private helper methods for range insertion and erasure:
+
+  link_nodes_before(): add n nodes before a given one
+                                              (O(n + log N))
+  cut_nodes(): take n consecutive nodes out of the tree (not
+               out of the list) (O(log N))
+
+  unlinked_data(): get the data of an unlinked node (O(1))
+*/
+
+#ifndef _AVL_ARRAY_JOIN_SPLIT_HPP_
+#define _AVL_ARRAY_JOIN_SPLIT_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// join_trees(): make a subtree with the nodes of the subtree
+// a, then the node k, and then the nodes of the subtree b (a
+// and b may be NULL), and return its root. If the heights of
+// a and b differ in more than one level, k is placed in the
+// spine of the higher one (the right spine of a, or the left
+// one of b), at the first node whose height is close enough
+// to the height of the other subtree, with that node and the
+// other subtree as children. With weight_balance, weights
+// are compared instead of heights (see out_of_balance()).
+// Then, the way up is rebalanced like after an insertion.
+// The climb is done under a temporary sentinel node, so that
+// rotations at the root need no special case. The returned
+// root is detached.
+//
+// Complexity: O(|h1-h2|+1) (heights of a and b)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::join_trees
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * a,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * k,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * b)
+{
+  node_t top;               // Temporary sentinel (above root)
+  node_t * p, * v;
+  size_type ha, hb;
+
+  AA_ASSERT (k);            // NULL pointer dereference
+
+  ha = balance_key (a);     // Heights (or ranks, or weights,
+  hb = balance_key (b);     // depending on B)
+
+  if (out_of_balance (ha, hb))   // a is higher: go down its
+  {                              // right spine until a node
+    top.m_children[L] = a;       // that is not much higher
+    a->m_parent = &top;          // than b
+
+    for (p=a;
+         out_of_balance (balance_key (p->m_children[R]), hb);
+         p=p->m_children[R]);
+
+    v = p->m_children[R];      //   p            p
+    p->m_children[R] = k;      //    \            \.
+    k->m_parent = p;           //     v   =>>      k
+    a = v;                     //                 / \.
+  }                            //                v   b
+  else if (out_of_balance (hb, ha))   // b is higher
+  {                                   // (symmetric)
+    top.m_children[L] = b;
+    b->m_parent = &top;
+
+    for (p=b;
+         out_of_balance (balance_key (p->m_children[L]), ha);
+         p=p->m_children[L]);
+
+    v = p->m_children[L];
+    p->m_children[L] = k;
+    k->m_parent = p;
+    b = v;
+  }
+  else                      // Similar heights: k is the root
+  {
+    top.m_children[L] = k;
+    k->m_parent = &top;
+  }
+
+  k->m_children[L] = a;     // Link k with its new children
+  k->m_children[R] = b;
+
+  if (a) a->m_parent = k;
+  if (b) b->m_parent = k;
+                            // (k's rank, with wavl_balance)
+  k->m_height = std::max (k->left_height (),
+                          k->right_height ()) + 1;
+
+  update_counters_and_rebalance (k);   // (stops above top)
+
+  p = top.m_children[L];    // Detach the resulting root
+  p->m_parent = NULL;
+
+  return p;
+}
+
+// split_tree(): split the subtree t (detached, or NULL) in two
+// detached subtrees: l, with its first n nodes, and r, with
+// the rest. Going down to the split point, every node left
+// behind is joined with its subtree on the far side, and with
+// the part of the split that falls on its side. The costs of
+// these joins telescope, so the total is logarithmic.
+//
+// Complexity: O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::split_tree
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * t,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t *& l,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t *& r)
+{
+  node_t * a, * b, * x;
+  size_type m;
+
+  if (!t)
+  {
+    AA_ASSERT (!n);          // Not so many nodes
+    l = r = NULL;
+    return;
+  }
+
+  m = t->left_count ();
+  a = t->m_children[L];      // Detach t from its children
+  b = t->m_children[R];
+  t->m_children[L] = t->m_children[R] = NULL;
+
+  if (a) a->m_parent = NULL;
+  if (b) b->m_parent = NULL;
+
+  if (n <= m)
+  {
+    split_tree (a, n, l, x);     // The split is on the left:
+    r = join_trees (x, t, b);    // t goes to the right part
+  }
+  else
+  {
+    split_tree (b, n-m-1, x, r); // The split is on the right:
+    l = join_trees (a, t, x);    // t goes to the left part
+  }
+}
+
+// append_nodes(): link n nodes (n>0), given in order in the
+// array v, at the end (or at the beginning, if front is true)
+// of the sequence. All but one of them are built into a
+// perfectly balanced subtree (the list links are set at the
+// same time), and it is joined with the current tree through
+// the remaining one. With bP, the new nodes take consecutive
+// labels next to the ones of the old end, if there's room
+// there (otherwise, all the labels are spread again, which
+// rarely happens). The nodes must not be linked in any tree.
+//
+// Complexity: O(n + log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::append_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * const * v,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   bool front)
+{
+  const P max = std::numeric_limits<P>::max ();
+
+  node_t * root, * sub, * k, * next, * last;
+  size_type i;
+  P lo;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+  AA_ASSERT (n>0);
+
+  for (i=0; i+1<n; i++)             // Make a list (m_next)
+    v[i]->m_next = v[i+1];
+  v[n-1]->m_next = NULL;
+
+  if (!front)
+  {
+    k = v[0];                       // k goes right after the
+    next = k->m_next;               // current last node, and
+    last = node_t::m_prev;          // the rest after k
+    lo = bP && last->m_parent ? *last->m_oldpos : P(0);
+  }
+  else
+  {
+    k = v[n-1];                     // The rest go right after
+    next = v[0];                    // the dummy (before the
+    last = dummy ();                // current first node), and
+    lo = 0;                         // k after them
+
+    if (bP && node_t::m_next->m_parent)
+      lo = *node_t::m_next->m_oldpos > P(n) ?
+           *node_t::m_next->m_oldpos - P(n) - 1 :
+           max;                     // (no room: see below)
+  }
+
+  root = node_t::m_children[L];     // Detach the current tree
+  if (root)                         // (after reading labels:
+    root->m_parent = NULL;          // no parent means dummy)
+
+  sub = NULL;
+
+  if (front && n>1)
+  {
+    sub = build_subtree (n-1, next, last);
+    last = v[n-2];
+  }
+
+  k->init_tree_fields ();           // Link k in the list
+  k->m_prev = last;
+  k->m_next = last->m_next;
+  k->m_prev->m_next = k;
+  k->m_next->m_prev = k;
+
+  if (!front && n>1)
+    sub = build_subtree (n-1, next, k);
+
+  root = front ? join_trees (sub, k, root) :
+                 join_trees (root, k, sub);
+
+  node_t::m_children[L] = root;     // Link it to the dummy again
+  root->m_parent = dummy ();
+  update_counters (dummy ());
+
+  if (bP)                           // Order labels
+  {
+    if (size_type(P(n))==n &&       // (n must fit in P)
+        lo < max - 1 && max - 1 - lo >= P(n))
+      relabel_nodes (v[0], n, lo + 1, lo + P(n));
+    else
+      relabel_all ();
+  }
+}
+
+// detach_nodes(): take the first n nodes (or the last ones,
+// if front is false) out of the tree, and store them, in
+// order, in the array v. The tree is split at the right
+// position, and the other part becomes the whole tree. The
+// nodes taken out are left with meaningless links.
+//
+// Complexity: O(n + log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::detach_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t ** v,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   bool front)
+{
+  node_t * root, * l, * r, * p;
+  size_type i;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+  AA_ASSERT (n<=size ());
+
+  if (!n)
+    return;
+
+  root = node_t::m_children[L];     // Detach the current tree
+  root->m_parent = NULL;            // and split it
+
+  split_tree (root, front ? n : size () - n, l, r);
+
+  if (front)
+  {
+    for (i=0, p=node_t::m_next; i<n; i++, p=p->m_next)
+      v[i] = p;                     // Take the first n nodes
+
+    node_t::m_next = p;             // Cut them from the list
+    p->m_prev = dummy ();
+    root = r;                       // Keep the rest
+  }
+  else
+  {
+    for (i=n, p=node_t::m_prev; i>0; i--, p=p->m_prev)
+      v[i-1] = p;                   // Take the last n nodes
+
+    node_t::m_prev = p;             // Cut them from the list
+    p->m_next = dummy ();
+    root = l;                       // Keep the rest
+  }
+
+  node_t::m_children[L] = root;     // Link it to the dummy again
+  if (root)
+    root->m_parent = dummy ();
+  update_counters (dummy ());
+}
+
+// link_nodes_before(): link n new nodes (n>1), given in
+// order in a list (m_next) that starts with first, right
+// before the node p (p may be the dummy). The tree is split
+// at p's position; the first and the last new nodes join the
+// left part, a perfectly balanced subtree with the rest of
+// them, and the right part, like in append_nodes(). With bP,
+// the new nodes take labels evenly spread between the ones
+// of their neighbours, if there's room there (otherwise, all
+// the labels are spread again, which rarely happens). Only
+// the nodes on the paths of the split and the joins are
+// touched.
+//
+// Complexity: O(n + log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::link_nodes_before
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * first,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  const P max = std::numeric_limits<P>::max ();
+
+  node_t * root, * l, * r, * sub, * next, * last;
+  my_class * a;
+  size_type pos;
+  P lo, hi;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+  AA_ASSERT (n>1);
+  AA_ASSERT (first);        // NULL pointer dereference
+
+  lo = bP && p->m_prev->m_parent ? *p->m_prev->m_oldpos : P(0);
+  hi = bP && p->m_parent ? *p->m_oldpos : max;
+
+  pos = position_of_node (p, a, false);
+
+  root = node_t::m_children[L];     // Detach the current tree
+  if (root)                         // and split it at p
+    root->m_parent = NULL;
+
+  split_tree (root, pos, l, r);
+
+  next = first->m_next;             // Link the first new node
+  first->init_tree_fields ();       // in the list, before p
+  first->m_prev = p->m_prev;
+  first->m_next = p;
+  first->m_prev->m_next = first;
+  p->m_prev = first;
+
+  sub = n>2 ? build_subtree (n-2, next, first) : NULL;
+
+  last = next;                      // And the last one, after
+  last->init_tree_fields ();        // the rest of them
+  last->m_prev = p->m_prev;
+  last->m_next = p;
+  last->m_prev->m_next = last;
+  p->m_prev = last;
+
+  root = join_trees (join_trees (l, first, sub), last, r);
+
+  node_t::m_children[L] = root;     // Link it to the dummy again
+  root->m_parent = dummy ();
+  update_counters (dummy ());
+
+  if (bP)                           // Order labels
+  {
+    if (size_type(P(n))==n && hi - lo > P(n))
+      relabel_nodes (first, n, lo + 1, hi - 1);
+    else
+      relabel_all ();
+  }
+}
+
+// cut_nodes(): take the n nodes found at the positions
+// [pos,pos+n) out of the tree, without touching the list.
+// The tree is split around them, and the two remaining
+// parts are joined through the first node of the right
+// one. The nodes taken out are left with meaningless tree
+// links.
+//
+// Complexity: O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::cut_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type pos,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
+{
+  node_t * root, * l, * m, * r, * k;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+  AA_ASSERT (pos+n<=size ());
+
+  if (!n)
+    return;
+
+  root = node_t::m_children[L];     // Detach the current tree
+  root->m_parent = NULL;            // and split it in three
+
+  split_tree (root, pos, l, r);
+  split_tree (r, n, m, r);
+
+  if (r)
+  {
+    split_tree (r, 1, k, r);        // Take out the first node
+    root = join_trees (l, k, r);    // of the right part, and
+  }                                 // join through it
+  else
+    root = l;
+
+  node_t::m_children[L] = root;     // Link it to the dummy again
+  if (root)
+    root->m_parent = dummy ();
+  update_counters (dummy ());
+}
+
+// unlinked_data(): get (by reference) the data of a node
+// that is not linked in any tree (data() refuses nodes
+// without parent, which it takes for end())
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  typename avl_array<T,A,bW,W,bP,P,B>::reference
+  avl_array<T,A,bW,W,bP,P,B>::unlinked_data
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  AA_ASSERT (p);            // NULL pointer dereference
+
+  return payload_node_t::payload (p);
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
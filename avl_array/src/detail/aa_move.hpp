@@ -30,11 +30,9 @@
   move_node(): extract and insert in other pos. (O(log N))
   move_nodes(): move n nodes to another pos. *
 
-  (*) Complexity of group moves:
-      If the source and destination containers are the same, then
-      the complexity is O(min{N, n log N})
-      Otherwise, it is O(min{N, n log N} + min{M, n log M}), where
-      M and N are the containers' sizes
+  (*) Complexity of group moves: O(n + log N + log M), where
+      M and N are the containers' sizes (the range is cut out
+      of the source tree and joined to the destination one)
 */
 
 #ifndef _AVL_ARRAY_MOVE_HPP_
@@ -60,42 +58,42 @@ namespace mkr  // Public namespace
 // Complexity: O(1) without NPSV or with NPSV but eq. widths
 //             O(log N) with NPSV and different widths
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::swap
-  (typename avl_array<T,A,bW,W,bP,P>::iterator it1,
-   typename avl_array<T,A,bW,W,bP,P>::iterator it2)
+  avl_array<T,A,bW,W,bP,P,B>::swap
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator it1,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator it2)
 {
   swap_nodes (it1.ptr, it2.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::swap
-  (typename avl_array<T,A,bW,W,bP,P>::iterator it1,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it2)
+  avl_array<T,A,bW,W,bP,P,B>::swap
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator it1,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it2)
 {
   swap_nodes (it1.ptr, it2.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::swap
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it1,
-   typename avl_array<T,A,bW,W,bP,P>::iterator it2)
+  avl_array<T,A,bW,W,bP,P,B>::swap
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it1,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator it2)
 {
   swap_nodes (it1.ptr, it2.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::swap
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it1,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it2)
+  avl_array<T,A,bW,W,bP,P,B>::swap
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it1,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it2)
 {
   swap_nodes (it1.ptr, it2.ptr);
 }
@@ -114,22 +112,22 @@ inline
 //
 // Complexity: O(log(N)), or O(1) in special cases
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator it,
-   typename avl_array<T,A,bW,W,bP,P>::difference_type n)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator it,
+   typename avl_array<T,A,bW,W,bP,P,B>::difference_type n)
 {
   move_node (it.ptr, n);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator it,
-   typename avl_array<T,A,bW,W,bP,P>::difference_type n)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator it,
+   typename avl_array<T,A,bW,W,bP,P,B>::difference_type n)
 {
   move_node (it.ptr, -n);     // Reverse ---> -n
 }
@@ -142,42 +140,42 @@ inline
 // (where M and N are the numbers of elements in source
 // and destination arrays respectively)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator src,
-   typename avl_array<T,A,bW,W,bP,P>::iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator src,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator dst)
 {
   move_node (src.ptr, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator src,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator src,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst)
 {
   move_node (src.ptr, dst.ptr->m_next);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src,
-   typename avl_array<T,A,bW,W,bP,P>::iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator dst)
 {
   move_node (src.ptr, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst)
 {
   move_node (src.ptr, dst.ptr->m_next);
 }
@@ -187,46 +185,46 @@ inline
 //
 // Complexity: see note at the beginnig of this file
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   typename avl_array<T,A,bW,W,bP,P>::iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator dst)
 {
   move_nodes (src_from, n, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   typename avl_array<T,A,bW,W,bP,P>::iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator dst)
 {
   move_nodes (src_from, n, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst)
 {
   move_nodes (src_from, n, dst.ptr->m_next, true);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst)
 {
   move_nodes (src_from, n, dst.ptr->m_next, true);
 }
@@ -236,13 +234,13 @@ inline
 //
 // Complexity: see note at the beginnig of this file
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_to,
-   typename avl_array<T,A,bW,W,bP,P>::iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_to,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator dst)
 {
   difference_type n;
   AA_ASSERT_HO (owner(src_from.ptr)==owner(src_to.ptr));
@@ -250,13 +248,13 @@ inline
   if (n>0) move_nodes (src_from, size_type(n), dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_to,
-   typename avl_array<T,A,bW,W,bP,P>::iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_to,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator dst)
 {
   difference_type n;
   AA_ASSERT_HO (owner(src_from.ptr)==owner(src_to.ptr));
@@ -264,13 +262,13 @@ inline
   if (n>0) move_nodes (src_from, size_type(n), dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_to,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_to,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst)
 {
   difference_type n;
   AA_ASSERT_HO (owner(src_from.ptr)==owner(src_to.ptr));
@@ -279,13 +277,13 @@ inline
                        dst.ptr->m_next, true);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_to,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst)
+  avl_array<T,A,bW,W,bP,P,B>::move
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_to,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst)
 {
   difference_type n;
   AA_ASSERT_HO (owner(src_from.ptr)==owner(src_to.ptr));
@@ -299,12 +297,12 @@ inline
 //
 // Complexity: see note at the beginnig of this file
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src)
 {
   AA_ASSERT_HO (owner(dst.ptr)==this);
   AA_ASSERT (&src!=this);
@@ -313,12 +311,12 @@ inline
               dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src)
 {
   AA_ASSERT_HO (owner(dst.ptr)==this);
   AA_ASSERT (&src!=this);
@@ -335,13 +333,13 @@ inline
 // (where M and N are the numbers of elements in source
 // and destination arrays respectively)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_from)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from)
 {
   AA_ASSERT_HO (owner(dst.ptr)==this);
   AA_ASSERT_HO (owner(src_from.ptr)==&src);
@@ -349,13 +347,13 @@ inline
   move_node (src_from.ptr, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_from)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from)
 {
   AA_ASSERT_HO (owner(dst.ptr)==this);
   AA_ASSERT_HO (owner(src_from.ptr)==&src);
@@ -363,13 +361,13 @@ inline
   move_node (src_from.ptr, dst.ptr->m_next);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from)
 {
   AA_ASSERT_HO (owner(dst.ptr)==this);
   AA_ASSERT_HO (owner(src_from.ptr)==&src);
@@ -377,13 +375,13 @@ inline
   move_node (src_from.ptr, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from)
 {
   AA_ASSERT_HO (owner(dst.ptr)==this);
   AA_ASSERT_HO (owner(src_from.ptr)==&src);
@@ -396,14 +394,14 @@ inline
 //
 // Complexity: see note at the beginnig of this file
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_to)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_to)
 {
   difference_type n;
 
@@ -416,14 +414,14 @@ inline
   if (n>0) move_nodes (src_from, n, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::iterator src_to)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator src_to)
 {
   difference_type n;
 
@@ -437,14 +435,14 @@ inline
                        dst.ptr->m_next, true);  // Reverse
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_to)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_to)
 {
   difference_type n;
 
@@ -457,14 +455,14 @@ inline
   if (n>0) move_nodes (src_from, n, dst.ptr);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::splice
-  (typename avl_array<T,A,bW,W,bP,P>::reverse_iterator dst,
-   typename avl_array<T,A,bW,W,bP,P>::my_class & src,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_from,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator src_to)
+  avl_array<T,A,bW,W,bP,P,B>::splice
+  (typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator dst,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class & src,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_from,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator src_to)
 {
   difference_type n;
 
@@ -484,12 +482,14 @@ inline
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  void avl_array<T,A,bW,W,bP,P>::reverse ()
+  void avl_array<T,A,bW,W,bP,P,B>::reverse ()
 {
   node_t * p, * next, * tmp;
 
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
   next = node_t::m_next;
 
   while (next!=dummy())   // For every node (excepting the
@@ -508,7 +508,9 @@ template<class T,class A,bool bW,class W,bool bP,class P>
   tmp = node_t::m_next;             // For the dummy node, swap
   node_t::m_next = node_t::m_prev;  // prev (last) and next (first)
   node_t::m_prev = tmp;             // links, but don't touch
-}                                   // children links
+                                    // children links
+  relabel_all ();                   // Order labels (with bP)
+}
 
 
 // ------------------- PRIVATE HELPER METHODS --------------------
@@ -529,12 +531,12 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 // Complexity: O(1) without NPSV or with NPSV but eq. widths
 //             O(log N) with NPSV and different widths
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::swap_nodes
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p,
-   typename avl_array<T,A,bW,W,bP,P>::node_t * q)
+  avl_array<T,A,bW,W,bP,P,B>::swap_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * q)
 {
   node_t * tmp, tmpnode;
 
@@ -545,9 +547,14 @@ template<class T,class A,bool bW,class W,bool bP,class P>
                  q->m_parent,
                  invalid_op_with_end());   // Can't move end()
 
+  AA_ASSERT_HO (!owner(p)->m_in_batch &&   // See begin_batch()
+                !owner(q)->m_in_batch);
+
   if (p==q)   // Self swap is nosense
     return;
 
+  same_allocator (p, q);   // Nodes can't go to a tree with a
+                           // different allocator
   // 1st: doubly linked list swap
 
   if (q->m_next==p)   // If they are contiguous, force
@@ -581,6 +588,10 @@ template<class T,class A,bool bW,class W,bool bP,class P>
     q->m_prev = tmp;
   }
 
+  if (bP)                    // Swap order labels too (each
+    std::swap (*p->m_oldpos, // one stays in its position)
+               *q->m_oldpos);
+
   // 2nd: binary tree swap
 
   if (q==p->m_parent)  // If they are parent-child of each
@@ -657,7 +668,7 @@ template<class T,class A,bool bW,class W,bool bP,class P>
   if (q->m_children[R])
     q->m_children[R]->m_parent = q;
 
-  if (!(*p->m_node_width==*q->m_node_width))
+  if (bW && !(*p->m_node_width==*q->m_node_width))
   {
     do
     {
@@ -682,12 +693,12 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::move_node
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p,
-   typename avl_array<T,A,bW,W,bP,P>::difference_type n)
+  avl_array<T,A,bW,W,bP,P,B>::move_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::difference_type n)
 {
   int side;
   node_t * q, * r;
@@ -697,6 +708,8 @@ template<class T,class A,bool bW,class W,bool bP,class P>
   AA_ASSERT_EXC (p->m_parent,
                  invalid_op_with_end());  // Can't move end()
 
+  AA_ASSERT_HO (!owner(p)->m_in_batch);   // See begin_batch()
+
   if (!n ||                      // If n==0 or
       (p->m_count==1 &&          // the node to move is
        !p->m_parent->m_parent))  // alone in the array,
@@ -762,6 +775,9 @@ template<class T,class A,bool bW,class W,bool bP,class P>
   p->m_children[R] = NULL;   // Reset other links and
   p->m_count = 1;            // counters of p
   p->m_height = 1;
+
+  if (bP)                    // New order label (see
+    label_node (p);          // detail/aa_order.hpp)
                                      // Two branches might be
   update_counters_and_rebalance (q); // unbalanced now: source
   update_counters_and_rebalance (r); // and destination of p
@@ -773,12 +789,12 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   void
-  avl_array<T,A,bW,W,bP,P>::move_node
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p,
-   typename avl_array<T,A,bW,W,bP,P>::node_t * q)
+  avl_array<T,A,bW,W,bP,P,B>::move_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * q)
 {
   AA_ASSERT (p);            // NULL pointer dereference
   AA_ASSERT (q);            // NULL pointer dereference
@@ -789,7 +805,13 @@ inline
   AA_ASSERT_EXC (p->m_parent,
                  invalid_op_with_end());  // Can't move end node
 
+  AA_ASSERT_HO (!owner(p)->m_in_batch &&  // See begin_batch()
+                !owner(q)->m_in_batch);
+
+  same_allocator (p, q);    // Nodes can't go to a tree with a
+                            // different allocator
   update_counters_and_rebalance (extract_node (p));
+  p->init_tree_fields ();   // Leaf (height and count too)
   insert_before (p, q);
 }
 
@@ -798,18 +820,18 @@ inline
 // direction of the destination iterator (true: insert in
 // inverse order and _after_ dst)
 //
-// Complexity: O(min{N, n log N})
+// Complexity: O(n + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class IT>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::move_nodes
+  avl_array<T,A,bW,W,bP,P,B>::move_nodes
   (IT src_from,                                // Source
    typename avl_array<T,A,bW,W,
-                          bP,P>::size_type n,  // # nodes to move
+                          bP,P,B>::size_type n,  // # nodes to move
    typename avl_array<T,A,bW,W,
-                          bP,P>::node_t * dst, // Destination
+                          bP,P,B>::node_t * dst, // Destination
    bool reverse)                               // Dest. direction
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -824,7 +846,7 @@ template<class IT>
 
   my_class * s, * d;
   node_t * next, * first, * last;
-  bool rebuild_tree, dest_extracted;
+  bool dest_extracted;
 
   AA_ASSERT (src_from.ptr);
   AA_ASSERT (dst);
@@ -832,16 +854,18 @@ template<class IT>
   s = owner (src_from.ptr);
   d = owner (dst);
 
-  rebuild_tree = false;
+  AA_ASSERT (!d->m_in_batch);  // See begin_batch()
+
+  AA_ASSERT_EXC (s==d || alloc_traits_t::always_equal ||
+                 s->allocator==d->allocator,
+                 allocator_mismatch());  // Nodes can't go to a tree
+                                         // with a different allocator
 
   dest_extracted =         // Detect source-destination overlap
       s->extract_nodes
         (src_from, n,      // Source
          first, last,      // Pointers passed by reference!
          dst,              // Destination (just for checking)
-         s==d ?            // If src and dest are in the same tree,
-           &rebuild_tree : // rebuild only once, after reinsertion
-           NULL,
          reverse);         // If the destination was specified with
                            // a reverse iter., make a reverse list
 
@@ -853,23 +877,18 @@ template<class IT>
   if (reverse)             // If dest is reverse, "before" means
     dst = dst->m_next;     // "after" from a 'straight' POV
 
-  if (!rebuild_tree &&                // No delayed rebuild _and_
-      !worth_rebuild(n,d->size()))    // 'few' elements
+  if (n<=2)                           // 'few' elements
   {
     while (first)                     // Repeat n times:
     {
       next = first;                   // Insert before dst
       first = first->m_next;          // (after previously
-      insert_before (next, dst);      // inserted copies)
+      next->init_tree_fields ();      // inserted copies, as
+      insert_before (next, dst);      // a leaf)
     }
   }
-  else                                // 'many' elements
-  {
-    last->m_next = dst;               // Splice list and
-    dst->m_prev->m_next = first;      // rebuild tree
-
-    d->build_known_size_tree (n+d->size(), d->m_next);
-  }
+  else                                // 'many' elements: join
+    d->link_nodes_before (first, n, dst);  // them as a subtree
 }
 
 //////////////////////////////////////////////////////////////////
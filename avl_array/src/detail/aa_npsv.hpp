@@ -19,8 +19,19 @@
   npsv_pos_of(): get an element's position O(log N) or O(N)*
   npsv_at_pos(): get elem. of a position O(log N) or O(N)*
   npsv_insert(): insert and set width O(log N)
+  npsv_sample(): draw k elements, weighted by their widths
+                 O(k log k + min{N, k log N})
+  for_each_overlapping(): call f for every width (interval)
+                          overlapping [lo,hi]
+                          O(min{N, (k+1) log N})*
   (*) width sums need to be updated
   (**) don't update width sums (lazy mode)
+
+  Private helper methods:
+
+  npsv_sample_nodes(): find sorted positions in a subtree
+  for_each_overlapping_nodes(): visit the overlapping widths
+                                of a subtree
 */
 
 #ifndef _AVL_ARRAY_NON_PROPORTIONAL_SEQUENCE_VIEW_HPP_
@@ -47,10 +58,10 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::npsv_update_sums (bool force) const
+  avl_array<T,A,bW,W,bP,P,B>::npsv_update_sums (bool force) const
 {
   AA_ASSERT (bW);
 
@@ -102,14 +113,14 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(1), or O(N) if sums were not up to date
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  const W & avl_array<T,A,bW,W,bP,P>::npsv_width () const
+  const W & avl_array<T,A,bW,W,bP,P,B>::npsv_width () const
 {
   AA_ASSERT (bW);
 
-  if (!bW)
-    return *(W*)0;
+  if (!bW)                             // (a static dummy)
+    return *node_t::m_node_width;
 
   if (m_sums_out_of_date)
     npsv_update_sums ();
@@ -123,15 +134,15 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  const W & avl_array<T,A,bW,W,bP,P>::npsv_width
-  (typename avl_array<T,A,bW,W,bP,P>::const_iterator it) const
+  const W & avl_array<T,A,bW,W,bP,P,B>::npsv_width
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_iterator it) const
 {
   AA_ASSERT (bW);
   AA_ASSERT (it.ptr);          // it must point somewhere
 
-  return bW ? *it.ptr->m_node_width : *(W*)0;
+  return *it.ptr->m_node_width;  // (a static dummy without bW)
 }
 
 // npsv_set_width(): modify the width of a node (the
@@ -144,11 +155,11 @@ inline
 //
 // Complexity: O(log N), or O(1) if update_sums==false
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::npsv_set_width
-  (const typename avl_array<T,A,bW,W,bP,P>::iterator & it,
+  avl_array<T,A,bW,W,bP,P,B>::npsv_set_width
+  (const typename avl_array<T,A,bW,W,bP,P,B>::iterator & it,
    const W & w,
    bool update_sums)
 {
@@ -161,6 +172,7 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 
   AA_ASSERT (it.ptr);                 // it must point somewhere
   AA_ASSERT_HO (owner(it.ptr)==this); // it must point here
+  AA_ASSERT (!m_in_batch);            // See begin_batch()
 
   AA_ASSERT_EXC (it.ptr->m_parent,       // Can't change
                  invalid_op_with_end()); // end's width
@@ -185,11 +197,11 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N), or O(N) if sums are out of date
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   W
-  avl_array<T,A,bW,W,bP,P>::npsv_pos_of
-  (typename avl_array<T,A,bW,W,bP,P>::const_iterator it) const
+  avl_array<T,A,bW,W,bP,P,B>::npsv_pos_of
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_iterator it) const
 {
   AA_ASSERT (bW);
 
@@ -242,10 +254,10 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N), or O(N) if sums are out of date
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::npsv_at_pos
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::npsv_at_pos
   (W pos, bool first)
 {
   AA_ASSERT (bW);
@@ -315,10 +327,10 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 // npsv_at_pos() _const_: See non-const version (above) for
 // details.
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::const_iterator
-  avl_array<T,A,bW,W,bP,P>::npsv_at_pos
+  typename avl_array<T,A,bW,W,bP,P,B>::const_iterator
+  avl_array<T,A,bW,W,bP,P,B>::npsv_at_pos
   (W pos, bool first)                   const
 {
   AA_ASSERT (bW);
@@ -341,11 +353,11 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N), or O(N) if sums are out of date
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::npsv_at_pos
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::npsv_at_pos
   (W pos, CMP cmp, bool first)
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -409,11 +421,11 @@ template<class CMP>
 // npsv_at_pos() _const_: See non-const version (above) for
 // details.
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_iterator
-  avl_array<T,A,bW,W,bP,P>::npsv_at_pos
+  typename avl_array<T,A,bW,W,bP,P,B>::const_iterator
+  avl_array<T,A,bW,W,bP,P,B>::npsv_at_pos
   (W pos, CMP cmp, bool first)          const
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -433,17 +445,18 @@ inline
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::npsv_insert
-  (const typename avl_array<T,A,bW,W,bP,P>::iterator & it, // Where
-   typename avl_array<T,A,bW,W,bP,P>::const_reference t,   // What
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::npsv_insert
+  (const typename avl_array<T,A,bW,W,bP,P,B>::iterator & it, // Where
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reference t, // What
    const W & w)                                            // Width
 {
   node_t * newnode;
 
   AA_ASSERT (bW);
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
   newnode = new_node (&t);
 
   if (bW)
@@ -454,6 +467,243 @@ inline
   return iterator(newnode);
 }
 
+// npsv_sample(): draw k elements at random, with a
+// probability proportional to their widths (elements with
+// zero width are never drawn). Iterators to the drawn
+// elements are written to out, and the final position of
+// out is returned. rng is called like the generator of
+// std::random_shuffle(), but with W values: rng(w) must
+// return a uniformly distributed W in [0,w).
+//
+// With replacement, the k positions are drawn first, then
+// they are sorted, and all of them are located in a single
+// descent (positions that share a path share the visit of
+// its nodes). The output is in sequence order then, and an
+// element can appear several times.
+//
+// Without replacement, every drawn element gets a zero
+// width until the end of the call (so that it can't be
+// drawn again), and then its width is restored. The
+// output is in drawing order, and fewer than k elements
+// are drawn if the positive widths run out first. If rng
+// or out throw, the widths are restored before rethrowing.
+//
+// Complexity: O(k log k + min{N, k log N}) with
+// replacement, O(k log N) without it (plus O(N) if sums
+// are out of date)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class RNG, class OIT>
+//not inline
+  OIT
+  avl_array<T,A,bW,W,bP,P,B>::npsv_sample
+  (RNG & rng,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type k,
+   OIT out,
+   bool with_replacement)
+{
+  AA_ASSERT (bW);
+
+  if (!bW)
+    return out;
+
+  std::vector<W> pos;
+  std::vector<std::pair<node_t*,W> > drawn;
+  iterator it;
+  W total;
+  size_type i;
+
+  total = npsv_width ();   // (updates sums if necessary)
+
+  if (k==0 || !(W(0)<total))         // Nothing to draw
+    return out;
+
+  if (with_replacement)
+  {
+    pos.reserve (k);
+
+    for (i=0; i<k; i++)              // Draw all positions,
+      pos.push_back (rng (total));   // sort them and find
+                                     // them all in a single
+    std::sort (pos.begin (), pos.end ());  // descent
+
+    return npsv_sample_nodes (node_t::m_children[L], W(0),
+                              &pos[0], &pos[0]+k, out);
+  }
+
+  drawn.reserve (k);
+
+  try
+  {
+    for (i=0; i<k && W(0)<total; i++)
+    {
+      pos.assign (1, rng (total));         // Draw one position,
+                                           // find its element,
+      npsv_sample_nodes (node_t::m_children[L], W(0),
+                         &pos[0], &pos[0]+1, &it);
+
+      drawn.push_back (std::make_pair (it.ptr,         // save
+                                       *it.ptr->m_node_width));
+      npsv_set_width (it, W(0));           // its width and
+      *out++ = it;                         // drop it (for now)
+
+      total = node_t::total_width ();
+    }
+  }
+  catch (...)
+  {
+    for (i=drawn.size(); i--; )             // Restore widths
+      npsv_set_width (iterator(drawn[i].first),  // (in reverse
+                      drawn[i].second);          // order) and
+    throw;                                       // rethrow
+  }
+
+  for (i=drawn.size(); i--; )
+    npsv_set_width (iterator(drawn[i].first), drawn[i].second);
+
+  return out;
+}
+
+// for_each_overlapping(): call f with an iterator to every
+// element whose width overlaps the closed interval [lo,hi],
+// in sequence order, and return f. W must be an interval
+// type like npsv_interval<E> (constructible from two E
+// bounds, with a method overlaps()), so that the total
+// width of every subtree is the hull of its intervals, and
+// the subtrees whose hull doesn't overlap [lo,hi] can be
+// skipped. The result is correct in any order, but the
+// complexity below requires the elements to be sorted by
+// lo (e.g. with insert_sorted() and an op.< on lo).
+//
+// Complexity: O(min{N, (k+1) log N}), or O(N) if sums are
+// out of date
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class E, class F>
+inline
+  F avl_array<T,A,bW,W,bP,P,B>::for_each_overlapping
+  (const E & lo, const E & hi, F f)
+{
+  AA_ASSERT (bW);
+
+  if (!bW)
+    return f;
+
+  if (m_sums_out_of_date)
+    npsv_update_sums ();
+
+  if (node_t::m_children[L])
+    for_each_overlapping_nodes<iterator> (node_t::m_children[L],
+                                          W(lo,hi), f);
+  return f;
+}
+
+// for_each_overlapping() _const_: See non-const version
+// (above) for details. f receives const iterators.
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class E, class F>
+inline
+  F avl_array<T,A,bW,W,bP,P,B>::for_each_overlapping
+  (const E & lo, const E & hi, F f)                      const
+{
+  AA_ASSERT (bW);
+
+  if (!bW)
+    return f;
+
+  if (m_sums_out_of_date)
+    npsv_update_sums ();
+
+  if (node_t::m_children[L])
+    for_each_overlapping_nodes<const_iterator>
+                     (node_t::m_children[L], W(lo,hi), f);
+  return f;
+}
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// npsv_sample_nodes(): find the elements of the sorted
+// positions [from,to) in the subtree of p, whose leftmost
+// node is in the position offset, and write iterators to
+// them in out (in sequence order). Positions lesser than
+// the node's left side go to the left subtree, positions
+// beyond its right side go to the right subtree, and the
+// rest are the node itself. If rounding errors of W send
+// positions to a missing subtree, they stay in the node.
+//
+// Complexity: O(min{n, k log n}) for a subtree of n nodes
+// and k positions
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class OIT>
+//not inline
+  OIT
+  avl_array<T,A,bW,W,bP,P,B>::npsv_sample_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   W offset, const W * from, const W * to, OIT out)
+{
+  const W * mid1, * mid2;
+  W left, right, w;
+
+  left = offset;                      // Sides of p in the
+  p->get_left_width (w);              // alternative sequence
+  left += w;
+  right = left;
+  right += *p->m_node_width;
+
+  mid1 = std::lower_bound (from, to, left);  // [from,mid1): left
+  mid2 = std::lower_bound (mid1, to, right); // [mid1,mid2): p
+                                             // [mid2,to): right
+  if (!p->m_children[L])
+    mid1 = from;
+
+  if (!p->m_children[R])
+    mid2 = to;
+
+  if (from<mid1)
+    out = npsv_sample_nodes (p->m_children[L], offset,
+                             from, mid1, out);
+
+  for (; mid1<mid2; ++mid1)
+    *out++ = iterator (p);
+
+  if (mid2<to)
+    out = npsv_sample_nodes (p->m_children[R], right,
+                             mid2, to, out);
+
+  return out;
+}
+
+// for_each_overlapping_nodes(): call f with an IT to every
+// node of the subtree of p whose width overlaps q, in
+// sequence order. The recursion stops at the subtrees whose
+// total width (hull) doesn't overlap q.
+//
+// Complexity: O(min{n, (k+1) log n}) for a subtree of n
+// nodes with k of them overlapping
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class IT, class F>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::for_each_overlapping_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   const W & q, F & f)
+{
+  if (!q.overlaps (p->total_width ()))  // Nothing here
+    return;
+
+  if (p->m_children[L])
+    for_each_overlapping_nodes<IT> (p->m_children[L], q, f);
+
+  if (q.overlaps (*p->m_node_width))
+    f (IT (p));
+
+  if (p->m_children[R])
+    for_each_overlapping_nodes<IT> (p->m_children[R], q, f);
+}
+
 //////////////////////////////////////////////////////////////////
 
 }  // namespace mkr
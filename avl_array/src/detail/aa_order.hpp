@@ -0,0 +1,267 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_order.hpp
+  -------------------
+
+  Order-maintenance labels: when bP is true, every node stores
+  in m_oldpos a label that grows along the sequence, so that
+  the relative order of two nodes (and iterators) can be
+  decided by comparing their labels, without climbing to the
+  root. The dummy node is considered to be after every node,
+  and its label is never read. Labels are kept in [1,max-1]
+  (max being the greatest value of P), and are given out in
+  the style of Bender et al.: a new node takes the midpoint of
+  the gap between its neighbours; if there's no gap, the
+  smallest enclosing aligned range of labels that is not too
+  crowded is found, and its nodes are spread evenly in it.
+  If P can't hold more distinct labels than nodes (the default
+  std::size_t always can), all the labels are set to 0, which
+  means "no labels": comparisons fall back to positions
+  (O(log N)) until a relabelling of all the nodes finds room
+  again.
+
+  Private helper methods:
+
+  label_node(): give a label to a newly linked node
+                                     (O(1), amortized O(log N))
+  relabel_nodes(): spread n labels evenly in a range (O(n))
+  relabel_all(): spread all labels in the whole range (O(N))
+  node_precedes(): compare the positions of two nodes
+                                    (O(1) with bP, else O(log N))
+*/
+
+#ifndef _AVL_ARRAY_ORDER_HPP_
+#define _AVL_ARRAY_ORDER_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// label_node(): give a label to the node p, which has just
+// been linked in the list (its neighbours are already
+// labelled). If there is room between the labels of the
+// previous and next nodes, take the middle. Otherwise, look
+// at aligned ranges of labels of growing size 2^i around the
+// previous label, until one of them has less than (2/T)^i
+// nodes (T=1.25, so the allowed density drops a bit on every
+// level), and relabel its nodes evenly. The sparser the
+// range chosen, the longer it takes to fill it again, which
+// makes the amortized cost O(log N). Without labels (see
+// relabel_nodes()), p just gets a 0 too.
+//
+// Complexity: O(1), amortized O(log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::label_node
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
+{
+  const P max = std::numeric_limits<P>::max ();
+  const int bits = std::numeric_limits<P>::digits;
+
+  P lo, hi, base, w;
+  node_t * first, * last;
+  size_type n;
+  double limit;
+  int i;
+
+  AA_ASSERT (p);             // NULL pointer dereference
+  AA_ASSERT (p->m_parent);   // The dummy has no label
+
+  lo = p->m_prev->m_parent ?      // Labels of the neighbours
+       *p->m_prev->m_oldpos :     // (the dummy counts as 0
+       P(0);                      // before the first node,
+  hi = p->m_next->m_parent ?      // and as max after the
+       *p->m_next->m_oldpos :     // last one)
+       max;
+
+  if ((p->m_prev->m_parent && !lo) ||
+      (p->m_next->m_parent && !hi))
+  {
+    *p->m_oldpos = 0;             // No labels
+    return;
+  }
+
+  if (hi - lo > 1)                // Room between them?
+  {
+    *p->m_oldpos = lo + (hi - lo) / 2;
+    return;
+  }
+
+  base = lo;            // Grow the range around the previous
+  first = last = p;     // label, counting the nodes whose
+  n = 1;                // labels are in it (first..last)
+  limit = 1.0;
+
+  for (i=1; ; i++)
+  {
+    limit *= 1.6;                     // (2/T)^i
+
+    if (i<bits)
+    {
+      w = P(1) << i;                  // Aligned range of
+      lo = base - base % w;           // 2^i labels
+      hi = lo + (w - 1);
+    }
+    else
+    {
+      lo = 0;                         // The whole range
+      hi = max;
+    }
+
+    while (first->m_prev->m_parent &&
+           !(*first->m_prev->m_oldpos < lo))
+    {
+      first = first->m_prev;          // Extend first..last
+      n ++;                           // to every node in
+    }                                 // the range
+
+    while (last->m_next->m_parent &&
+           !(hi < *last->m_next->m_oldpos))
+    {
+      last = last->m_next;
+      n ++;
+    }
+
+    if (lo==0) lo = 1;                // Labels 0 and max are
+    if (hi==max) hi = max - 1;        // reserved for the dummy
+
+    if (i>=bits ||
+        (n<=limit && n-1<=size_type(hi-lo)))
+      break;                          // Sparse enough
+  }
+
+  relabel_nodes (first, n, lo, hi);
+}
+
+// relabel_nodes(): give n consecutive nodes, starting with
+// p, labels evenly spread in the range [lo,hi]. If there
+// are less than n labels in the range (which only happens
+// when n is the whole array, and P is too small for it), or
+// the array has no labels already (a neighbour has a 0),
+// the nodes get a 0 instead: no labels at all.
+//
+// Complexity: O(n)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::relabel_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   P lo, P hi)
+{
+  P step, label;
+  node_t * q;
+  size_type i;
+
+  if (!n)
+    return;
+
+  for (q=p, i=1; i<n; i++)                // Node after the
+    q = q->m_next;                        // last one
+  q = q->m_next;
+
+  if (size_type(P(n))!=n ||               // P is too small
+      hi - lo < P(n-1) ||
+      (p->m_prev->m_parent && !*p->m_prev->m_oldpos) ||
+      (q->m_parent && !*q->m_oldpos))     // No labels
+    step = label = 0;
+  else
+  {
+    step = (hi - lo) / P(n) +             // hi-lo+1 slots
+           ((hi - lo) % P(n) + 1) / P(n); // (without overflow)
+    label = lo + step/2;
+  }
+
+  for (;;)
+  {
+    AA_ASSERT (p->m_parent);   // Never the dummy
+
+    *p->m_oldpos = label;
+    p = p->m_next;
+
+    if (!--n)
+      break;
+
+    label += step;             // (not past the last one)
+  }
+}
+
+// relabel_all(): relabel all nodes, spreading the labels
+// evenly in the whole range
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::relabel_all ()
+{
+  if (bP)
+    relabel_nodes (node_t::m_next, size (), P(1),
+                   std::numeric_limits<P>::max () - 1);
+}
+
+// node_precedes(): tell whether the node a comes before
+// the node b in the sequence (or after, if reverse is
+// true). The dummy node (end) is after every node in both
+// directions. With labels, this is just a comparison of
+// them; otherwise (or if they are 0, see relabel_nodes()),
+// the positions are computed. Both nodes must belong to
+// the same array.
+//
+// Complexity: O(1) with bP, O(log N) otherwise
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  bool
+  avl_array<T,A,bW,W,bP,P,B>::node_precedes
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t * a,
+   const typename avl_array<T,A,bW,W,bP,P,B>::node_t * b,
+   bool reverse)
+{
+  my_class * x, * y;
+  difference_type m, n;
+
+  AA_ASSERT (a);            // NULL pointer dereference
+  AA_ASSERT (b);            // NULL pointer dereference
+
+  if (bP)
+  {
+    if (!a->m_parent) return false;   // end() is after all
+    if (!b->m_parent) return true;
+
+    if (*a->m_oldpos && *b->m_oldpos)
+      return reverse ? *b->m_oldpos < *a->m_oldpos :
+                       *a->m_oldpos < *b->m_oldpos;
+  }
+
+  m = difference_type (position_of_node (a, x, reverse));
+  n = difference_type (position_of_node (b, y, reverse));
+
+  AA_ASSERT (x==y);  // Inter-array order has no sense
+
+  return reverse ? n < m : m < n;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
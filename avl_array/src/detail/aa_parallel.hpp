@@ -0,0 +1,484 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_parallel.hpp
+  ----------------------
+
+  Methods for parallel traversal and copy (they use several
+  threads only if AA_USE_THREADS is defined; otherwise they
+  are sequential):
+
+  parallel_for_each(): call f for every element (O(N/th + th log N))
+  parallel_reduce(): combine all elements with op     "
+  parallel_assign(): copy another avl_array or a random access
+                     sequence (O(M + N/th + N))
+
+  Private helper methods:
+
+  thread_count(): number of threads to use (O(1))
+  run_jobs(): run k jobs in several threads (O(k) + jobs)
+  chunk_start(): position of a chunk in a range (O(1))
+  split_range(): cut a range in balanced chunks (O(k log N))
+  run_chunks(): process the chunks in several threads
+  run_chunk(): process a single chunk (O(chunk size))
+  parallel_build(): construct chunks of nodes in several threads
+                    and build the tree with them
+*/
+
+#ifndef _AVL_ARRAY_PARALLEL_HPP_
+#define _AVL_ARRAY_PARALLEL_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// parallel_for_each(): call f (an object with an overloaded
+// operator() which receives a T&) for every element in
+// [first,last). The range is cut in chunks of the same size
+// using the subtree counts (see split_range()), and the
+// chunks are distributed among nthreads threads (0 means
+// "as many as hardware threads"). Every thread takes a new
+// chunk when it finishes the previous one, so that uneven
+// costs of f are balanced. The same f object is shared by
+// all threads, so it must support concurrent calls. The
+// array must not be modified structurally meanwhile. If f
+// throws, the remaining chunks are abandoned and the
+// exception is re-thrown in the calling thread.
+// Without AA_USE_THREADS, this is a plain sequential loop.
+//
+// Complexity: O(N/th + th log N)
+// (where th is the number of threads)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class F>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::parallel_for_each
+  (typename avl_array<T,A,bW,W,bP,P,B>::iterator first,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator last,
+   F f,
+   unsigned nthreads)
+{
+  for_each_worker<reference,F> w(f);
+  run_chunks (first.ptr, last.ptr, w, nthreads);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class F>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::parallel_for_each
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_iterator first,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_iterator last,
+   F f,
+   unsigned nthreads)
+{
+  for_each_worker<const_reference,F> w(f);
+  run_chunks (first.ptr, last.ptr, w, nthreads);
+}
+
+// parallel_reduce(): combine init and all the elements in
+// [first,last) with a binary operator op (an object with an
+// overloaded operator() which receives two V and returns a
+// V). Every chunk (see parallel_for_each()) is reduced
+// separately, starting with its first element converted to
+// V, and the partial results are combined in sequence
+// order. Therefore op must be associative, but it doesn't
+// need to be commutative, and init doesn't need to be an
+// identity element.
+//
+// Complexity: O(N/th + th log N)
+// (where th is the number of threads)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class V, class OP>
+//not inline
+  V
+  avl_array<T,A,bW,W,bP,P,B>::parallel_reduce
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_iterator first,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_iterator last,
+   V init,
+   OP op,
+   unsigned nthreads)
+{
+  reduce_worker<const_reference,V,OP> w(op);
+  size_type i;
+
+  run_chunks (first.ptr, last.ptr, w, nthreads);
+
+  for (i=0; i<w.partial.size(); i++)   // Combine the partial
+    init = op (init, w.partial[i]);    // results in order
+
+  return init;
+}
+
+// parallel_assign(): replace the current contents with a
+// copy of the contents of a. The range of a is cut in
+// chunks of the same size (see split_range()), and the
+// nodes of every chunk are allocated and copy-constructed
+// by a different thread, in a list of its own. Finally, the
+// lists are concatenated and the tree is built in a single
+// pass with build_known_size_tree() (this last step only
+// touches pointers and counters). If a T constructor (or
+// the allocator) throws, all new nodes are destroyed, the
+// current contents are kept, and the exception is
+// re-thrown. With AA_USE_THREADS, the allocator must
+// support concurrent calls to allocate(), and the T copy
+// constructor must be safe to call concurrently on
+// different source objects.
+//
+// Complexity: O(M + N/th + N)
+// (where M is the number of T objects to delete, and th is
+// the number of threads)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::parallel_assign
+  (const typename avl_array<T,A,bW,W,bP,P,B>::my_class & a,
+   unsigned nthreads)
+{
+  std::vector<node_t*> bounds;
+  std::vector<const_iterator> starts;
+  size_type n, k, i;
+
+  if (&a == this) return;
+
+  n = a.size ();
+  k = thread_count (nthreads);  // Construction costs are even:
+  if (k>n)                      // one chunk per thread
+    k = n;
+
+  if (k)
+    split_range (a.node_t::m_next, n, k, bounds);
+
+  for (i=0; i<k; i++)
+    starts.push_back (const_iterator(bounds[i]));
+
+  parallel_build<iter_aa_data_provider<const_pointer,
+                                       const_iterator, bW, W> >
+                (starts, n, nthreads);
+}
+
+// parallel_assign(): replace the current contents with a
+// copy of the sequence [from,to). The iterators must be
+// random access iterators (the start of every chunk is
+// computed as from+offset). See comments above.
+//
+// Complexity: O(M + N/th + N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template <class RAIT>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::parallel_assign (RAIT from, RAIT to,
+                                             unsigned nthreads)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< RandomAccessIteratorConcept<RAIT> >();
+#endif
+
+  std::vector<RAIT> starts;
+  size_type n, k, i;
+
+  n = size_type(to - from);
+  k = thread_count (nthreads);
+  if (k>n)
+    k = n;
+
+  for (i=0; i<k; i++)
+    starts.push_back (from + chunk_start(n,k,i));
+
+  parallel_build<iter_data_provider<const_pointer,RAIT> >
+                (starts, n, nthreads);
+}
+
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// thread_count(): number of threads to use for a requested
+// number nthreads (0 means "as many as hardware threads").
+// Without AA_USE_THREADS it is allways 1.
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  unsigned
+  avl_array<T,A,bW,W,bP,P,B>::thread_count (unsigned nthreads)
+{
+#ifdef AA_USE_THREADS
+  if (!nthreads)
+    nthreads = std::thread::hardware_concurrency ();
+
+  return nthreads ? nthreads : 1;
+#else
+  (void) nthreads;         // Unused
+  return 1;
+#endif
+}
+
+// run_jobs(): call job(c) for every c in [0,k). With
+// AA_USE_THREADS, nthreads-1 new threads are started and the
+// calling thread works too. Every thread claims the next
+// free job until none is left. If a job throws, the jobs
+// that were not started yet are abandoned, all threads are
+// joined, and the first exception is re-thrown. Without
+// AA_USE_THREADS, the jobs are run in order by the calling
+// thread.
+//
+// Complexity: O(k) + jobs
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class JOB>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::run_jobs
+  (JOB & job,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type k,
+   unsigned nthreads)
+{
+  size_type c;
+
+  nthreads = thread_count (nthreads);
+
+#ifdef AA_USE_THREADS
+  if (nthreads>1 && k>1)
+  {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(nthreads);
+    std::atomic<size_type> next_job(0);
+    std::atomic<bool> failed(false);
+    unsigned t;
+
+    auto run = [&] (unsigned id)
+    {
+      size_type j;
+
+      try
+      {
+        while (!failed &&
+               (j=next_job++)<k)     // Claim the next job
+          job (j);
+      }
+      catch (...)
+      {
+        errors[id] = std::current_exception ();
+        failed = true;
+      }
+    };
+
+    for (t=1; t<nthreads && t<k; t++)
+      threads.push_back (std::thread(run, t));
+
+    run (0);                         // This thread works too
+
+    for (t=0; t<threads.size(); t++)
+      threads[t].join ();
+
+    for (t=0; t<nthreads; t++)       // Re-throw the first
+      if (errors[t])                 // exception (if any)
+        std::rethrow_exception (errors[t]);
+
+    return;
+  }
+#endif
+
+  for (c=0; c<k; c++)                // Sequential version
+    job (c);
+}
+
+// chunk_start(): position of the chunk i, when a range of n
+// elements is cut in k chunks of (almost) the same size (the
+// first n%k chunks get an extra element)
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline //static
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::chunk_start
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type k,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type i)
+{
+  return n / k * i + (i < n % k ? i : n % k);
+}
+
+// split_range(): cut the range that starts at first and has
+// n nodes in k chunks of (almost) the same size. Store the
+// k+1 boundaries in bounds. Every boundary is reached with
+// a jump() from the previous one, which climbs only as far
+// as the subtree containing both.
+//
+// Complexity: O(k log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::split_range
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * first,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type k,
+   std::vector<node_t*> & bounds)
+{
+  size_type i, pos, next;
+
+  bounds.resize (k+1);
+  bounds[0] = first;
+
+  for (i=1, pos=0; i<=k; i++)
+  {
+    next = chunk_start (n, k, i);
+    bounds[i] = jump (bounds[i-1],
+                      difference_type(next-pos), false);
+    pos = next;
+  }
+}
+
+// run_chunks(): cut [first,last) in chunks and call the
+// worker for every node, running one job per chunk (see
+// run_jobs())
+//
+// Complexity: O(N/th + th log N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class WK>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::run_chunks
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * first,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * last,
+   WK & worker,
+   unsigned nthreads)
+{
+  std::vector<node_t*> bounds;
+  my_class * a, * b;
+  size_type n, k, i;
+  unsigned t;
+
+  AA_ASSERT (first);            // NULL pointer dereference
+  AA_ASSERT (last);
+
+  n = position_of_node (last, b, false);
+  i = position_of_node (first, a, false);
+
+  AA_ASSERT (a==b);             // Same array
+  AA_ASSERT (i<=n);             // Valid range
+
+  n -= i;
+
+  if (!n)
+    return;
+
+  t = thread_count (nthreads);
+                          // Some more chunks than threads, for
+  k = t==1 ? 1 : t*4;     // balancing uneven costs
+  if (k>n)
+    k = n;
+
+  split_range (first, n, k, bounds);
+  worker.prepare (k);
+
+  chunk_job<my_class,node_t*,WK> job(worker, bounds);
+  run_jobs (job, k, t);
+}
+
+// run_chunk(): call the worker for every node of the chunk
+// c, which is [from,to). Only the m_next links are used, so
+// different chunks can be processed concurrently.
+//
+// Complexity: O(chunk size)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class WK>
+inline //static
+  void
+  avl_array<T,A,bW,W,bP,P,B>::run_chunk
+  (WK & worker,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type c,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * from,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * to)
+{
+  AA_ASSERT (from!=to);           // Chunks are never empty
+
+  worker.first (c, data(from));
+
+  for (from=from->m_next; from!=to; from=from->m_next)
+    worker.next (c, data(from));
+}
+
+// parallel_build(): construct n new nodes in k chunks, in
+// several threads (see run_jobs()). The chunk c is copied
+// from a data provider of type DP created with starts[c].
+// Then replace the current contents with the new nodes.
+// If something fails, destroy all new nodes and re-throw.
+//
+// Complexity: O(M + N/th + N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class DP, class IT>
+//not inline
+  void
+  avl_array<T,A,bW,W,bP,P,B>::parallel_build
+  (const std::vector<IT> & starts,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   unsigned nthreads)
+{
+  size_type k, c, i;
+  node_t * p;
+
+  k = starts.size ();
+
+  std::vector<node_t*> firsts(k, (node_t*)NULL),
+                       lasts(k, (node_t*)NULL);
+  std::vector<size_type> counts(k);
+
+  for (c=0; c<k; c++)
+    counts[c] = chunk_start (n, k, c+1) - chunk_start (n, k, c);
+
+  build_job<my_class,node_t*,DP,IT> job(this, starts, counts,
+                                         firsts, lasts);
+  try
+  {
+    run_jobs (job, k, nthreads);
+  }
+  catch (...)
+  {
+    for (c=0; c<k; c++)       // Destroy the chunks that were
+      if (firsts[c])          // completed (the failed one
+        for (i=0; i<counts[c]; i++) // has been rolled back)
+        {
+          p = firsts[c];
+          firsts[c] = p->m_next;
+          delete_node (p);
+        }
+
+    throw;
+  }
+
+  for (c=1; c<k; c++)               // Concatenate the chunks
+    lasts[c-1]->m_next = firsts[c];
+
+  clear ();
+  build_known_size_tree (n, k ? firsts[0] : NULL);
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_partition.hpp
+  -----------------------
+
+  Methods for filtering and partitioning:
+
+  erase_if(): erase elements satisfying a predicate (O(N))
+  remove_if(): same as erase_if() (std::list interface)
+  partition(): put first those satisfying a pred. (O(N))
+  stable_partition(): idem (partition() is stable too) (O(N))
+
+  Private helper method:
+
+  partition_nodes(): relink nodes in two groups (O(N))
+*/
+
+#ifndef _AVL_ARRAY_PARTITION_HPP_
+#define _AVL_ARRAY_PARTITION_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// erase_if(): erase all the elements for which a predicate
+// (an object with an overloaded operator() which receives
+// a T& and returns a bool) returns true. The whole list is
+// traversed once, the surviving nodes are relinked and the
+// tree is rebuilt with build_known_size_tree(), so that no
+// rebalancing is done per erased element. Return the
+// number of erased elements.
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class PRED>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::erase_if (PRED pred)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires<
+      UnaryPredicateConcept<PRED,value_type> >();
+#endif
+
+  node_t * first, * p, * q, * dead;
+  size_type n, N;
+
+  N = size ();
+
+  if (!N)
+    return 0;
+
+  node_t::m_prev->m_next = NULL; // Detach the whole tree and use
+  first = node_t::m_next;        // it as an independent list
+
+  q = dummy ();                  // Tail of the surviving list
+  dead = NULL;                   // (dummy is a placeholder)
+  n = 0;
+
+  for (p=first; p; )
+    if (pred(data(p)))
+    {
+      q->m_next = p->m_next;     // Bypass the victim in the
+      p->m_next = dead;          // surviving list and keep
+      dead = p;                  // it aside
+      p = q->m_next;
+      n ++;
+    }
+    else
+    {
+      q = p;                     // Keep it
+      p = p->m_next;
+    }
+
+  if (!n)                        // Nothing erased: the tree is
+  {                              // still ok, just close the
+    node_t::m_prev->m_next = dummy ();  // loop again
+    return 0;
+  }
+
+  build_known_size_tree (N-n, node_t::m_next); // Build the tree
+                                               // again
+  while (dead)             // The tree is ok now
+  {
+    p = dead;              // Destroy removed nodes
+    dead = dead->m_next;
+    delete_node (p);
+  }
+
+  return n;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class PRED>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::remove_if (PRED pred)
+{
+  return erase_if (pred);    // Same as erase_if()
+}
+
+// partition(): arrange the elements so that all those
+// satisfying a predicate (an object with an overloaded
+// operator() which receives a T& and returns a bool) are
+// placed before all those that don't. Don't move the
+// elements in memory; just relink the nodes in one pass and
+// rebuild the tree. Since the relative order in both groups
+// is kept, this is a stable partition too. Return an
+// iterator referring the first element of the second group
+// (end() if it is empty).
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class PRED>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::partition (PRED pred)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires<
+      UnaryPredicateConcept<PRED,value_type> >();
+#endif
+
+  return iterator(partition_nodes (pred));
+}
+
+// stable_partition(): same as partition() (see comments
+// above). It is provided for interface compatibility
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class PRED>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::stable_partition (PRED pred)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires<
+      UnaryPredicateConcept<PRED,value_type> >();
+#endif
+
+  return iterator(partition_nodes (pred));
+}
+
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// partition_nodes(): detach the whole tree, split the list
+// in two lists (elements satisfying pred, and the rest),
+// keeping the relative order in both, concatenate them and
+// build the tree again. Return the first node of the second
+// group (or the dummy node if it is empty).
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class PRED>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::partition_nodes (PRED pred)
+{
+  node_t * p, * next, * yes_last, * no_first, * no_last;
+  size_type N;
+
+  N = size ();
+
+  if (!N)
+    return dummy ();
+
+  node_t::m_prev->m_next = NULL; // Detach the whole tree and use
+  next = node_t::m_next;         // it as an independent list
+
+  yes_last = dummy ();           // Dummy: head of the 1st group
+  no_first = no_last = NULL;
+
+  while (next)
+  {
+    p = next;
+    next = next->m_next;
+
+    if (pred(data(p)))
+      yes_last = yes_last->m_next = p;   // Append to 1st group
+    else if (no_first)
+      no_last = no_last->m_next = p;     // Append to 2nd group
+    else
+      no_first = no_last = p;
+  }
+
+  yes_last->m_next = no_first;   // Concatenate both groups
+  if (no_last)
+    no_last->m_next = NULL;
+
+  build_known_size_tree (N, node_t::m_next);
+
+  return no_first ? no_first : dummy ();
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
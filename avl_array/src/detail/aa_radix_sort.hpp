@@ -0,0 +1,215 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_radix_sort.hpp
+  ------------------------
+
+  Radix sort, for arrays of integers or of elements with an
+  integer key:
+
+  radix_sort(): sort integral elements (O(N*sizeof(T)))
+  radix_sort(key): sort by an integral key (O(N*sizeof(key)))
+
+  Private helper methods:
+
+  radix_sort_by(): the sort itself, given the type of the key
+  radix_byte(): get one digit of a key (O(1))
+
+  Private helper class (in mkr::detail):
+
+  radix_identity: key extractor that returns the element
+*/
+
+#ifndef _AVL_ARRAY_RADIX_SORT_HPP_
+#define _AVL_ARRAY_RADIX_SORT_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+class radix_identity           // Key extractor of radix_sort():
+{                              // the element is the key
+  public:
+
+    template<class T>
+    const T & operator() (const T & t) const { return t; }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// radix_sort(): sort the array in ascending order of the
+// integral key returned by key(element) (or of the elements
+// themselves, if they are integers), with an LSD radix sort
+// of 8 bits per digit. No element is copied nor compared:
+// the nodes are distributed in 256 buckets by relinking them
+// (m_next only), once per digit, and finally the tree is
+// rebuilt in perfect balance. Digits that are equal in every
+// key are skipped (e.g. the high bytes of timestamps). The
+// sort is stable. Signed keys are supported (negative values
+// go first). The key is extracted about once per node and
+// pass, so it should be cheap. If key throws, the elements
+// stay in the array, but their order is unspecified.
+//
+// Complexity: O(N*B), where B is the number of bytes of the key
+//             that are not equal in every element
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class KEY>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::radix_sort (KEY key)
+{
+  if (size()>1)
+    radix_sort_by (key, key (data (node_t::m_next)));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::radix_sort ()
+{
+  radix_sort (radix_identity());
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// radix_sort_by(): radix sort (see above), where k0 is the
+// key of the first element (it's only used for deducing the
+// type of the keys, K, and as a reference for finding the
+// digits that are equal in every key)
+//
+// Complexity: O(N*B)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class KEY, class K>
+//not inline
+  void avl_array<T,A,bW,W,bP,P,B>::radix_sort_by (KEY key, K k0)
+{
+#ifdef AA_CXX11
+  static_assert (std::numeric_limits<K>::is_integer,
+                 "radix_sort() requires an integral key");
+#endif
+
+  node_t * heads[256], * tails[256];   // Buckets (lists)
+  node_t * p, * first, * last;
+  K diff;
+  size_type n;
+  int d, b;
+
+  diff = K(0);                // Find the digits that change:
+                              // if key throws here, nothing
+  for (p=node_t::m_next->m_next;       // has changed yet
+       p!=dummy(); p=p->m_next)
+    diff |= K(key (data (p)) ^ k0);
+
+  n = size ();
+
+  node_t::m_prev->m_next = NULL; // Detach the whole tree and use
+  first = node_t::m_next;        // it as an independent list
+
+  for (d=0; d<int(sizeof(K)); d++)
+  {
+    if (!radix_byte (diff, d, false))  // Equal in every key
+      continue;
+
+    for (b=0; b<256; b++)
+      heads[b] = NULL;
+
+    p = first;
+
+    try
+    {
+      for (; p; p=p->m_next)           // Distribute (stable:
+      {                                // append to the bucket)
+        b = radix_byte (K(key (data (p))), d,
+                        d==int(sizeof(K))-1);
+
+        if (heads[b])
+          tails[b] = tails[b]->m_next = p;
+        else
+          heads[b] = tails[b] = p;
+      }
+    }
+    catch (...)
+    {
+      last = NULL;                     // Gather whatever is in
+      first = p;                       // the buckets, put it
+                                       // before the rest of the
+      for (b=255; b>=0; b--)           // list, rebuild the tree
+        if (heads[b])                  // and propagate
+        {
+          tails[b]->m_next = first;
+          first = heads[b];
+        }
+
+      build_known_size_tree (n, first);
+      throw;
+    }
+
+    first = last = NULL;               // Concatenate buckets
+
+    for (b=0; b<256; b++)
+      if (heads[b])
+      {
+        if (last)
+          last->m_next = heads[b];
+        else
+          first = heads[b];
+
+        last = tails[b];
+      }
+
+    last->m_next = NULL;
+  }
+
+  build_known_size_tree (n, first);
+}
+
+// radix_byte(): get the digit d (byte, 0 is the least
+// significant one) of the key k. If top is true (last digit
+// of a signed key), the sign bit is flipped, so that
+// negative values come first.
+//
+// Complexity: O(1)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class K>
+inline //static
+  int avl_array<T,A,bW,W,bP,P,B>::radix_byte (K k, int d, bool top)
+{
+  int b;
+
+  b = int ((k >> (8*d)) & 0xFF);   // (small k is promoted to
+                                   // int, and masked as such)
+
+  if (top && std::numeric_limits<K>::is_signed)
+    b ^= 0x80;
+
+  return b;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -48,11 +48,11 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(log(N))
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reference
-  avl_array<T,A,bW,W,bP,P>::operator[]
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)
+  typename avl_array<T,A,bW,W,bP,P,B>::reference
+  avl_array<T,A,bW,W,bP,P,B>::operator[]
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
 {
   AA_ASSERT_EXC (n>=0 && n<size(),
                  index_out_of_bounds());  // Index out of range
@@ -60,38 +60,38 @@ inline
   return data (node_at_pos(n));
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::reference
-  avl_array<T,A,bW,W,bP,P>::at
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)
+  typename avl_array<T,A,bW,W,bP,P,B>::reference
+  avl_array<T,A,bW,W,bP,P,B>::at
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
 {
   return operator[](n);     // And at() too
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reference
-  avl_array<T,A,bW,W,bP,P>::operator[]
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)    const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reference
+  avl_array<T,A,bW,W,bP,P,B>::operator[]
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)  const
 {
   return (*const_cast<my_class*>(this))[n];
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reference
-  avl_array<T,A,bW,W,bP,P>::operator()
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)    const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reference
+  avl_array<T,A,bW,W,bP,P,B>::operator()
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)  const
 {
   return operator[](n);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::const_reference
-  avl_array<T,A,bW,W,bP,P>::at
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)    const
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reference
+  avl_array<T,A,bW,W,bP,P,B>::at
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)  const
 {
   return operator[](n);
 }
@@ -109,12 +109,12 @@ inline
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::size_type
-  avl_array<T,A,bW,W,bP,P>::position_of_node
-  (const typename avl_array<T,A,bW,W,bP,P>::node_t * p,
-   typename avl_array<T,A,bW,W,bP,P>::my_class * & a,
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::position_of_node
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::my_class * & a,
    bool reverse)
 {
   size_type pos;
@@ -151,14 +151,16 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::node_at_pos
-  (typename avl_array<T,A,bW,W,bP,P>::size_type pos) const
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::node_at_pos
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type pos) const
 {
   node_t * p;
 
+  AA_ASSERT (!m_in_batch);   // Counts are stale in a batch
+
   //                             // Out of bounds: end()
   //if (pos<0 ||                 // currently impossible,
   //    pos>=size())             // due to the fact that
@@ -205,12 +207,12 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::jump
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p,
-   typename avl_array<T,A,bW,W,bP,P>::difference_type n,
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::jump
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p,
+   typename avl_array<T,A,bW,W,bP,P,B>::difference_type n,
    bool reverse)
 {
   difference_type i;
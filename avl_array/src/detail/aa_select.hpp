@@ -0,0 +1,536 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_select.hpp
+  --------------------
+
+  Selection methods, for when only some elements of the sorted
+  sequence are needed:
+
+  nth_element(): put the n'th element in place (O(N) expected)
+  partial_sort(): sort only the first k elements
+                                        (O(N + k log k) expected)
+  top_k(): copy the first k of the sorted sequence, without
+           modifying the array (O(N log k))
+
+  Private helper methods:
+
+  select_nodes(): introselect on a list of nodes (O(n) expected)
+  sort_nodes(): stable merge sort of a list of nodes (O(n log n))
+  merge_nodes(): merge two sorted lists of nodes (O(n))
+
+  Private helper class (in mkr::detail):
+
+  deref_cmp: compare pointed objects (for the heap of top_k())
+*/
+
+#ifndef _AVL_ARRAY_SELECT_HPP_
+#define _AVL_ARRAY_SELECT_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+template<class CMP>             // Comparison of pointers through
+class deref_cmp                 // the objects they point to
+{
+  public:
+
+    deref_cmp (CMP cmp) : m_cmp(cmp) {}
+
+    template<class X>
+    bool operator() (const X * a, const X * b) const
+    { return m_cmp (*a, *b); }
+
+  private:
+
+    CMP m_cmp;
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// nth_element(): reorder the array so that the element at
+// position n is the one that would be there if the whole
+// array was sorted with cmp (or with T::operator<), no
+// element before it is greater, and no element after it is
+// lesser. The nodes are detached from the tree and
+// partitioned as a list (no element is copied), picking
+// the pivots with a median of three, and the tree is
+// rebuilt at the end. If the partitions go wrong too many
+// times, the remaining part is simply sorted, so that the
+// worst case is O(N log N) (introselect). The version that
+// takes an iterator uses the position it refers now.
+// Return an iterator to the n'th element. Like in sort(),
+// cmp is not expected to throw.
+//
+// Complexity: O(N) expected, O(N log N) worst case
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::nth_element
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n, CMP cmp)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires<
+      BinaryFunctionConcept<CMP,int,const_reference,
+                                    const_reference> >();
+#endif
+
+  node_t * first;
+  size_type N;
+
+  AA_ASSERT_EXC (n<size (), index_out_of_bounds());
+
+  N = size ();
+
+  if (N>1)
+  {
+    node_t::m_prev->m_next = NULL; // Detach the whole tree and
+    first = node_t::m_next;        // use it as an independent
+                                   // list
+    first = select_nodes (first, N, n, cmp);
+    build_known_size_tree (N, first);
+  }
+
+  return iterator (node_at_pos (n));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::nth_element
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< LessThanComparableConcept<value_type> >();
+#endif
+
+  return nth_element (n, std::less<value_type>());
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::nth_element
+  (const typename avl_array<T,A,bW,W,bP,P,B>::iterator & pos,
+   CMP cmp)
+{
+  AA_ASSERT_HO (owner(pos.ptr)==this);
+
+  return nth_element (size_type(pos - begin ()), cmp);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::nth_element
+  (const typename avl_array<T,A,bW,W,bP,P,B>::iterator & pos)
+{
+  return nth_element (pos, std::less<value_type>());
+}
+
+// partial_sort(): reorder the array so that its first k
+// elements are the k lesser ones, in order (the order of
+// the rest is unspecified). This is nth_element() for the
+// position k-1, followed by a merge sort of the first k
+// nodes only (still as a list, before rebuilding the tree).
+//
+// Complexity: O(N + k log k) expected
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+//not inline
+  void avl_array<T,A,bW,W,bP,P,B>::partial_sort
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type k, CMP cmp)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires<
+      BinaryFunctionConcept<CMP,int,const_reference,
+                                    const_reference> >();
+#endif
+
+  node_t * first, * rest, * p;
+  size_type N, i;
+
+  N = size ();
+
+  if (k>N)
+    k = N;
+
+  if (k==0 || N<2)
+    return;
+
+  node_t::m_prev->m_next = NULL; // Detach the whole tree and use
+  first = node_t::m_next;        // it as an independent list
+
+  if (k<N)                       // The k lesser ones first
+    first = select_nodes (first, N, k-1, cmp);
+
+  for (p=first, i=1; i<k; i++)   // Cut the list after them,
+    p = p->m_next;               // sort them, and glue the
+                                 // rest again
+  rest = p->m_next;
+  p->m_next = NULL;
+
+  first = sort_nodes (first, cmp);
+
+  for (p=first; p->m_next; p=p->m_next) ;
+  p->m_next = rest;
+
+  build_known_size_tree (N, first);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::partial_sort
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type k)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< LessThanComparableConcept<value_type> >();
+#endif
+
+  partial_sort (k, std::less<value_type>());
+}
+
+// top_k(): copy to out the first k elements (or size(), if
+// less) of the sequence that sort(cmp) would produce, in
+// that order, without modifying the array. A heap of (at
+// most) k pointers to the best elements found so far is
+// kept while the array is traversed once. The order among
+// equal elements is unspecified. Return the end of the
+// output.
+//
+// Complexity: O(N log k)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP, class OIT>
+//not inline
+  OIT avl_array<T,A,bW,W,bP,P,B>::top_k
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type k,
+   CMP cmp, OIT out) const
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires<
+      BinaryFunctionConcept<CMP,int,const_reference,
+                                    const_reference> >();
+#endif
+
+  std::vector<const_pointer> heap;  // Max-heap (by cmp)
+  deref_cmp<CMP> dcmp(cmp);
+  node_t * p;
+  size_type i;
+
+  if (k>size ())
+    k = size ();
+
+  if (k==0)
+    return out;
+
+  heap.reserve (k);
+
+  for (p=node_t::m_next; p!=dummy(); p=p->m_next)
+    if (heap.size ()<k)                   // Fill the heap
+    {
+      heap.push_back (&data (p));
+      std::push_heap (heap.begin (), heap.end (), dcmp);
+    }
+    else if (cmp (data (p), *heap.front ()))  // Better than
+    {                                         // the worst one?
+      std::pop_heap (heap.begin (), heap.end (), dcmp);
+      heap.back () = &data (p);                   // Replace it
+      std::push_heap (heap.begin (), heap.end (), dcmp);
+    }
+
+  std::sort_heap (heap.begin (), heap.end (), dcmp);
+
+  for (i=0; i<k; i++)
+    *out++ = *heap[i];
+
+  return out;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class OIT>
+inline
+  OIT avl_array<T,A,bW,W,bP,P,B>::top_k
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type k, OIT out) const
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< LessThanComparableConcept<value_type> >();
+#endif
+
+  return top_k (k, std::less<value_type>(), out);
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// select_nodes(): reorder a NULL terminated list of n nodes
+// so that the node at position t is the one that would be
+// there in a sorted list, with no greater one before it and
+// no lesser one after it. Return the new first node. Every
+// round partitions the current part of the list in three
+// (lesser, equal and greater than a median of three) and
+// keeps only the one containing t; the parts that are done
+// pile up before and after it. After 2*log2(n) rounds, or
+// when the current part is small, it is just sorted.
+//
+// Complexity: O(n) expected, O(n log n) worst case
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::select_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * first,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type t,
+   CMP cmp)
+{
+  node_t * head, * head_last;   // Done: before the current part
+  node_t * tail;                // Done: after the current part
+  node_t * lists[3], * lasts[3];    // Lesser, equal, greater
+  size_type counts[3];
+  node_t * p, * a, * b, * c;
+  const_pointer pivot;
+  size_type i, rounds;
+  int side;
+
+  AA_ASSERT (t<n);
+
+  head = head_last = tail = NULL;
+
+  for (rounds=0, i=n; i; i>>=1)  // 2*log2(n) rounds at most
+    rounds += 2;
+
+  while (n>16 && rounds--)
+  {
+    a = b = first;                    // Median of three: first,
+                                      // middle and last nodes
+    for (p=first, i=1; i<n; i++)
+    {
+      if (i==n/2)
+        b = p;
+
+      p = p->m_next;
+    }
+
+    c = p;
+
+    if (cmp (data (b), data (a))) std::swap (a, b);  // a <= b
+    if (cmp (data (c), data (b)))                    // Then, b is
+      b = cmp (data (c), data (a)) ? a : c;          // the median
+
+    pivot = &data (b);
+
+    for (side=0; side<3; side++)
+    {
+      lists[side] = lasts[side] = NULL;
+      counts[side] = 0;
+    }
+
+    for (p=first; p; p=p->m_next)     // Partition (stable)
+    {
+      side = cmp (data (p), *pivot) ? 0 :
+             cmp (*pivot, data (p)) ? 2 : 1;
+
+      if (lists[side])
+        lasts[side] = lasts[side]->m_next = p;
+      else
+        lists[side] = lasts[side] = p;
+
+      counts[side] ++;
+    }
+
+    for (side=0; side<3; side++)
+      if (lists[side])
+        lasts[side]->m_next = NULL;
+
+    if (t<counts[0])                  // In the lesser part:
+    {                                 // the rest goes after
+      for (side=2; side>0; side--)
+        if (lists[side])
+        {
+          lasts[side]->m_next = tail;
+          tail = lists[side];
+        }
+
+      first = lists[0];
+      n = counts[0];
+      continue;
+    }
+
+    for (side=0; side<2; side++)      // Otherwise, the lesser
+      if (lists[side])                // and equal parts go
+      {                               // before
+        if (head_last)
+          head_last->m_next = lists[side];
+        else
+          head = lists[side];
+
+        head_last = lasts[side];
+      }
+
+    if (t<counts[0]+counts[1])        // In the equal part:
+    {                                 // done, the greater part
+      if (lists[2])                   // goes after
+      {
+        lasts[2]->m_next = tail;
+        tail = lists[2];
+      }
+
+      first = NULL;
+      n = 0;
+      break;
+    }
+
+    t -= counts[0] + counts[1];       // In the greater part
+    first = lists[2];
+    n = counts[2];
+  }
+
+  if (n)                              // Sort what remains of
+    first = sort_nodes (first, cmp);  // the current part
+
+  if (first)
+  {
+    if (head_last)                    // Glue everything
+      head_last->m_next = first;
+    else
+      head = first;
+
+    for (head_last=first;
+         head_last->m_next;
+         head_last=head_last->m_next) ;
+  }
+
+  if (head_last)
+    head_last->m_next = tail;
+  else
+    head = tail;
+
+  return head;
+}
+
+// sort_nodes(): sort a NULL terminated list of nodes with a
+// stable, bottom-up merge sort, and return its new first
+// node. Bin i holds a sorted list of 2^i nodes (or none),
+// and every new node is carried up like in a binary counter.
+//
+// Complexity: O(n log n)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::sort_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * first, CMP cmp)
+{
+  node_t * bins[8*sizeof(size_type)];
+  node_t * carry;
+  size_type i, used;
+
+  used = 0;
+
+  while (first)
+  {
+    carry = first;               // Take the next node
+    first = first->m_next;
+    carry->m_next = NULL;
+
+    for (i=0; i<used && bins[i]; i++)
+    {
+      carry = merge_nodes (bins[i], carry, cmp);  // (bins[i]
+      bins[i] = NULL;                             // goes first)
+    }
+
+    bins[i] = carry;
+
+    if (i==used)
+      used ++;
+  }
+
+  carry = NULL;
+
+  for (i=0; i<used; i++)         // Merge all the bins (the
+    if (bins[i])                 // higher, the older)
+      carry = merge_nodes (bins[i], carry, cmp);
+
+  return carry;
+}
+
+// merge_nodes(): merge two sorted, NULL terminated lists of
+// nodes, and return the first node of the result. Among
+// equal elements, those of a go first.
+//
+// Complexity: O(n)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::merge_nodes
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * a,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * b,
+   CMP cmp)
+{
+  node_t * first, * last, * next;
+
+  first = last = NULL;
+
+  while (a && b)
+  {
+    if (cmp (data (b), data (a)))  // Take b only if strictly
+    {                              // lesser (stable)
+      next = b;
+      b = b->m_next;
+    }
+    else
+    {
+      next = a;
+      a = a->m_next;
+    }
+
+    if (first)
+      last = last->m_next = next;
+    else
+      first = last = next;
+  }
+
+  if (first)
+    last->m_next = a ? a : b;
+  else
+    first = a ? a : b;
+
+  return first;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/aa_serialize.hpp
+  -----------------------
+
+  Methods for saving/loading the contents to/from a stream:
+
+  save(): write elements (and NPSV widths) (O(N))
+  load(): replace the contents with saved data (O(N))
+
+  Private helper methods:
+
+  save_stream(): write header, elements and widths (O(N))
+  load_stream(): read them and build the tree (O(N))
+
+  Format (native: only the same platform and compiler settings
+  can read it back):
+
+    "AVLA"                       magic
+    size_type[4]                 version (1), sizeof(T) (0 if
+                                 a codec was given), sizeof(W)
+                                 (0 without NPSV), and N
+    N elements                   written by the codec
+    N widths (if sizeof(W)!=0)   raw bytes
+*/
+
+#ifndef _AVL_ARRAY_SERIALIZE_HPP_
+#define _AVL_ARRAY_SERIALIZE_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// save(): write the elements of the array to the stream os,
+// in sequence order, followed by their NPSV widths (if bW).
+// Without a codec, the bytes of every element are written
+// as they are in memory (see raw_codec). Otherwise, codec
+// writes every element (see detail/stream_codec.hpp). The
+// tree is not saved: load() builds a new one. Write errors
+// are reported by the state of os.
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::save (std::ostream & os) const
+{
+  raw_codec<T> codec;
+
+  save_stream (os, codec, sizeof (T));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class C>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::save (std::ostream & os,
+                                         C codec)          const
+{
+  save_stream (os, codec, 0);
+}
+
+// load(): replace the contents of the array with the data
+// written by save() (with the same codec, or without codec
+// in both cases). The nodes are created in a list, and
+// then linked as a perfectly balanced tree in a single
+// step (see build_known_size_tree()), with no rebalancing
+// at all. If the data doesn't match this type (T size,
+// codec or W size), or the stream ends too soon,
+// invalid_stream_data is thrown, and the array is not
+// modified. If the data has no widths, the elements get
+// the default width W(1).
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::load (std::istream & is)
+{
+  raw_codec<T> codec;
+
+  load_stream (is, codec, sizeof (T));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class C>
+inline
+  void avl_array<T,A,bW,W,bP,P,B>::load (std::istream & is,
+                                         C codec)
+{
+  load_stream (is, codec, 0);
+}
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// save_stream(): write the header (see the format above),
+// every element with codec, and every width (if bW), all
+// in sequence order. The list is followed directly (no
+// iterator needed).
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class C>
+//not inline
+  void avl_array<T,A,bW,W,bP,P,B>::save_stream
+  (std::ostream & os, C & codec,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type elem_size) const
+{
+  size_type header[4];
+  raw_codec<W> wcodec;
+  node_t * p;
+
+  header[0] = 1;                      // Version
+  header[1] = elem_size;              // 0: codec given
+  header[2] = bW ? sizeof (W) : 0;    // 0: no widths
+  header[3] = size ();
+
+  os.write ("AVLA", 4);
+  os.write (reinterpret_cast<const char*>(header),
+            sizeof (header));
+
+  for (p=node_t::m_next; p!=dummy(); p=p->m_next)  // Elements
+    codec.save (os, data (p));
+
+  if (bW)
+    for (p=node_t::m_next; p!=dummy(); p=p->m_next)  // Widths
+      wcodec.save (os, *p->m_node_width);
+}
+
+// load_stream(): read and check the header, then create a
+// list of nodes with the elements read by codec (see
+// construct_nodes_list() and stream_data_provider), read
+// their widths (if any), and only then replace the old
+// contents with a tree built from the list. If anything
+// fails, the list is destroyed and the array stays as it
+// was.
+//
+// Complexity: O(N)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class C>
+//not inline
+  void avl_array<T,A,bW,W,bP,P,B>::load_stream
+  (std::istream & is, C & codec,
+   typename avl_array<T,A,bW,W,bP,P,B>::size_type elem_size)
+{
+  char magic[4];
+  size_type header[4], n, i;
+  raw_codec<W> wcodec;
+  node_t * first, * last, * p;
+  stream_data_provider<const_pointer,T,C> dp(is, codec);
+
+  is.read (magic, 4);
+  is.read (reinterpret_cast<char*>(header), sizeof (header));
+
+  AA_ASSERT_EXC (!is.fail () &&
+                 std::equal (magic, magic+4, "AVLA") &&
+                 header[0]==1 &&                      // Version
+                 header[1]==elem_size &&              // T/codec
+                 (header[2]==0 ||                     // W
+                  (bW && header[2]==sizeof (W))) &&
+                 header[3]<=max_size (),
+                 invalid_stream_data());
+
+  n = header[3];
+
+  construct_nodes_list (first, last, n, dp);  // (rolls back
+                                              // by itself)
+  if (bW && header[2])
+  {
+    try
+    {
+      for (p=first, i=0; i<n; p=p->m_next, i++)
+        wcodec.load (is, *p->m_node_width);
+
+      AA_ASSERT_EXC (!is.fail (), invalid_stream_data());
+    }
+    catch (...)
+    {
+      for (i=0; i<n; i++)     // Delete the new nodes
+      {                       // and re-throw
+        p = first;
+        first = first->m_next;
+        delete_node (p);
+      }
+
+      throw;
+    }
+  }
+
+  clear ();                           // Replace the old
+  build_known_size_tree (n, first);   // contents
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
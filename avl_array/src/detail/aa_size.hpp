@@ -15,12 +15,8 @@
   size(): retrieve current size (O(1))
   empty(): true if empty; false otherwise (O(1))
   max_size(): estimated maximum size in theory (O(1))
-  resize(n): change size (O(min{N, n log N}))
+  resize(n): change size (O(|n-N| + log N))
   resize(n,t): idem, but add copies of t  "
-
-  Private helper methods:
-
-  resize(n,DP): change size (rebuild) O(max{old_size,new_size})
 */
 
 #ifndef _AVL_ARRAY_SIZE_HPP_
@@ -41,10 +37,10 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::size_type
-  avl_array<T,A,bW,W,bP,P>::size () const
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::size () const
 {
   return  node_t::m_count-1;
 }
@@ -53,10 +49,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::empty () const
+  avl_array<T,A,bW,W,bP,P,B>::empty () const
 {
   return size()==0;
 }
@@ -68,10 +64,10 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
-  typename avl_array<T,A,bW,W,bP,P>::size_type
-  avl_array<T,A,bW,W,bP,P>::max_size ()
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::max_size ()
 {
                              // If pointers are smaller or eq.
                              // to size_type, the limit is
@@ -105,111 +101,57 @@ template<class T,class A,bool bW,class W,bool bP,class P>
 // elements from the end, or appending copies of t
 // (depending on the specified new size n)
 //
-// Complexity: (O(min{N, n log N}))
+// Complexity: O(|n-N| + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::resize
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+  avl_array<T,A,bW,W,bP,P,B>::resize
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
 {
-  size_type sz=size();                  // If there's a big
-                                        // difference with
-  if (n<=0)                             // respect to the
-    clear ();                           // current size, resize
-  else if ((n>sz &&                     // building (linking)
-            worth_rebuild(n-sz,sz)) ||  // the whole tree again
-           (n<sz &&
-            worth_rebuild(sz-n,sz,true)))
-  {
-    copy_data_provider<const_pointer> dp(&t);
-    resize (n, dp);
-  }
-  else if (n>sz)                    // If the difference
-    insert (end(), n-size(), t);    // is small,
-  else if (n<sz)                    // append or remove
-    erase (begin()+n, end());       // elements one by one
+  size_type sz=size();
+
+  if (n<=0)                         // Nothing left
+    clear ();
+  else if (n>sz)                    // Append copies, or
+    insert (end(), n-sz, t);        // remove elements
+  else if (n<sz)                    // from the end (both
+    erase (begin()+n, end());       // O(|n-N| + log N))
 }
 
 // resize(): change the size of the avl_array, deleting
 // elements from the end, or appending default constructed
 // T objects (depending on the specified new size n)
 //
-// Complexity: (O(min{N, n log N}))
+// Complexity: O(|n-N| + log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 //not inline
   void
-  avl_array<T,A,bW,W,bP,P>::resize
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n)
+  avl_array<T,A,bW,W,bP,P,B>::resize
+  (typename avl_array<T,A,bW,W,bP,P,B>::size_type n)
 {
   null_data_provider<const_pointer> dp;
-  node_t * first, * last, * p;
-  size_type sz=size();                  // If there's a big
-                                        // difference with
-  if (n<=0)                             // respect to the
-    clear ();                           // current size, resize
-  else if ((n>sz &&                     // building (linking)
-            worth_rebuild(n-sz,sz)) ||  // the whole tree again
-           (n<sz &&
-            worth_rebuild(sz-n,sz,true)))
-    resize (n, dp);
-  else if (n<sz)                        // Otherwise append or
-    erase (begin()+n, end());           // remove elements one
-  else if (n>sz)                        // by one
+  node_t * first, * last;
+  size_type sz=size();
+
+  if (n<=0)                             // Nothing left
+    clear ();
+  else if (n<sz)                        // Remove elements
+    erase (begin()+n, end());           // from the end
+  else if (n>sz)                        // or append new ones
   {
     construct_nodes_list (first, last, n-sz, dp, false);
 
-    while (first)
-    {
-      p = first;
-      first = first->m_next;
-      insert_before (p, dummy());
-    }
+    if (n-sz==1)
+      insert_before (first, dummy());
+    else
+      link_nodes_before (first, n-sz, dummy());
   }
 }
 
 
-// ------------------- PRIVATE HELPER METHODS --------------------
-
-// resize(n,DP): change the size of the avl_array, deleting
-// elements from the end, or appending new elements
-// (depending on the specified new size n).
-// Do it rebuilding the whole tree in all cases
-//
-// Complexity: O(max{old_size,new_size})
-
-template<class T,class A,bool bW,class W,bool bP,class P>
-template<class DP>
-  void
-  avl_array<T,A,bW,W,bP,P>::resize
-  (typename avl_array<T,A,bW,W,bP,P>::size_type n,
-   DP & dp)
-{
-  node_t * first, * last;
-  node_t * p, * next;
-                                  // Build a new tree adding
-  if (n>size())                   // and/or recycling nodes
-  {
-    construct_nodes_list (first, last, n-size(), dp);
-    node_t::m_prev->m_next = first;
-    build_known_size_tree (n, node_t::m_next);
-  }
-  else
-  {
-    node_t::m_prev->m_next = NULL;
-    next = build_known_size_tree (n, node_t::m_next);
-
-    while (next)                  // Destruct remaining
-    {                             // old elements
-      p = next;
-      next = next->m_next;
-      delete_node (p);
-    }
-  }
-}
-
 //////////////////////////////////////////////////////////////////
 
 }  // namespace mkr
@@ -15,15 +15,18 @@
 
   binary_search(): fast search* (O(log N))
   insert_sorted(): insert keeping order* (O(log N))
+  insert_sorted(from,to): idem, a whole sequence*
+                                 (O(min{N+K log K, K log N}))
   sort(): impose order                          (O(N log N))
   stable_sort(): idem + keep current order between equals "
   merge(): mix two containers, keeping order* (O(M+N))
   unique(): remove duplicates* (O(N))
   (*) Elements must be previously in order
 
-  Private helper method:
+  Private helper methods:
 
   binary_search(): search value in a sorted tree (O(log N))
+  finger_search(): search starting at a given node (O(log d))
 */
 
 #ifndef _AVL_ARRAY_SORTED_SEARCH_TREE_HPP_
@@ -61,13 +64,13 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::const_iterator & it,
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_iterator & it,
    CMP cmp)                                          const
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -79,13 +82,13 @@ inline
   return binary_search (t, &it.ptr, cmp);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::iterator & it,
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator & it,
    CMP cmp)
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -97,13 +100,13 @@ inline
   return binary_search (t, &it.ptr, cmp);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::const_reverse_iterator & it,
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reverse_iterator & it,
    CMP cmp)                                          const
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -121,13 +124,13 @@ inline
   return found;                       // which t would be
 }                                     // is the previous
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator & it,
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator & it,
    CMP cmp)
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -145,12 +148,12 @@ inline
   return found;                       // which t would be
 }                                     // is the previous
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::iterator & it)
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::iterator & it)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -159,12 +162,12 @@ inline
   return binary_search (t, it, std::less<value_type>());
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::reverse_iterator & it)
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::reverse_iterator & it)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -173,12 +176,12 @@ inline
   return binary_search (t, it, std::less<value_type>());
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::const_iterator & it)
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_iterator & it)
                                                       const
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -188,12 +191,12 @@ inline
   return binary_search (t, it, std::less<value_type>());
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
-   typename avl_array<T,A,bW,W,bP,P>::const_reverse_iterator & it)
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::const_reverse_iterator & it)
                                                       const
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -203,11 +206,11 @@ inline
   return binary_search (t, it, std::less<value_type>());
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t)
+  avl_array<T,A,bW,W,bP,P,B>::binary_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t)
                                                       const
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -239,12 +242,12 @@ inline
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::insert_sorted
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::insert_sorted
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
    bool allow_duplicates,
    CMP cmp)
 {
@@ -256,6 +259,8 @@ inline
 
   node_t * pos, * newnode;
   bool found;
+
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
                                         // Search for the value
   found = binary_search (t, &pos, cmp); // (or the correct
                                         // insert point)
@@ -268,11 +273,11 @@ inline
   return iterator(newnode);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::iterator
-  avl_array<T,A,bW,W,bP,P>::insert_sorted
-  (typename avl_array<T,A,bW,W,bP,P>::const_reference t,
+  typename avl_array<T,A,bW,W,bP,P,B>::iterator
+  avl_array<T,A,bW,W,bP,P,B>::insert_sorted
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
    bool allow_duplicates)
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -283,6 +288,163 @@ inline
                         std::less<value_type>());
 }
 
+// Bulk sorted insert: insert copies of the elements of the
+// (unsorted) sequence [from,to) while maintaining the
+// _existing_ order in the avl_array, as if every element
+// had been inserted with insert_sorted(), but faster. The
+// new nodes are created first (if this throws, nothing has
+// changed), and sorted among them (stable). Then, if they
+// are 'many' (see worth_rebuild()), the two sorted lists
+// of nodes are merged in linear time and the tree is
+// rebuilt; otherwise, every node is inserted on its own,
+// but the search of its position starts at the previous
+// insertion point (finger search), instead of at the root.
+// New elements go after the existing elements that are
+// equal to them, and keep their relative order. If
+// allow_duplicates is false, the elements that are equal to
+// an existing one (or to a previous one of the sequence)
+// are discarded. The number of elements actually inserted
+// is returned.
+//
+// IMPORTANT: The whole avl_array must be in order
+// according to the comparison used. Otherwise, the result
+// will have no sense.
+//
+// Complexity: O(min{N + K log K, K log N})
+// (where K is the length of the sequence)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class IT, class CMP>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::insert_sorted
+  (IT from,
+   IT to,                // Originals (*to not included)
+   bool allow_duplicates,
+   CMP cmp)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< InputIteratorConcept<IT> >();
+  function_requires<
+      BinaryFunctionConcept<CMP,int,const_reference,
+                                    const_reference> >();
+#endif
+
+  node_t * first, * last, * p, * q, * dead;
+  range_data_provider<const_pointer,IT> dp(from,to);
+  size_type n, k;
+
+  if (from==to)              // Make a list with copies of the
+    return 0;                // range [from,to) and count them
+
+  n = construct_nodes_list (first, last, 0, dp, false, true);
+  last->m_next = NULL;
+
+  for (p=first; p; p=p->m_next)       // Not linked yet, but not
+    p->m_parent = dummy ();           // end() either (data()
+                                      // checks m_parent)
+  first = sort_nodes (first, cmp);    // Nothing throws from
+                                      // here (if cmp doesn't)
+  dead = NULL;
+  k = 0;
+
+  if (!worth_rebuild(n,size()))   // 'few' elements to insert
+  {
+    q = NULL;                     // Finger (last position)
+
+    do
+    {
+      p = first;
+      first = first->m_next;
+      q = finger_search (data(p), q, cmp);
+
+      if (!allow_duplicates &&          // Duplicate? (the one
+          q->m_prev->m_parent &&        // before is not greater)
+          !cmp (data(q->m_prev), data(p)))
+      {
+        q = q->m_prev;
+        p->m_next = dead;
+        dead = p;
+      }
+      else
+      {
+        insert_before (p, q);
+        q = p;
+        k ++;
+      }
+    }
+    while (first);
+  }
+  else            // If there are 'many' elements to insert,
+  {               // merge both lists and rebuild the tree
+    q = size() ? node_t::m_next : NULL;
+    if (q)
+      node_t::m_prev->m_next = NULL;
+    last = NULL;
+
+    while (q || first)
+    {
+      if (!first ||                       // Take the existing
+          (q && !cmp (data(first),        // one unless the new
+                      data(q))))          // one is lesser
+      {
+        p = q;
+        q = q->m_next;
+      }
+      else
+      {
+        p = first;
+        first = first->m_next;
+
+        if (!allow_duplicates && last &&  // Equal to the last
+            !cmp (data(last), data(p)))   // one: discard it
+        {
+          p->m_next = dead;
+          dead = p;
+          continue;
+        }
+
+        k ++;
+      }
+
+      if (last)
+        last->m_next = p;
+      else
+        node_t::m_next = p;
+
+      last = p;
+    }
+
+    build_known_size_tree (size()+k, node_t::m_next);
+  }
+
+  while (dead)                      // Release the discarded
+  {                                 // ones
+    p = dead;
+    dead = dead->m_next;
+    delete_node (p);
+  }
+
+  return k;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class IT>
+inline
+  typename avl_array<T,A,bW,W,bP,P,B>::size_type
+  avl_array<T,A,bW,W,bP,P,B>::insert_sorted
+  (IT from,
+   IT to,                // Originals (*to not included)
+   bool allow_duplicates)
+{
+#ifdef BOOST_CLASS_REQUIRE
+  function_requires< LessThanComparableConcept<value_type> >();
+#endif
+
+  return insert_sorted (from, to, allow_duplicates,
+                        std::less<value_type>());
+}
+
 // sort(): arrange the elements of the array so that the
 // resulting sequence follows a particular order. Don't
 // move the elements in memory; just compare them and
@@ -299,10 +461,10 @@ inline
 // Complexity: O(N log N)
 // (where N is the number of elements in the array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 //not inline
-  void avl_array<T,A,bW,W,bP,P>::sort (CMP cmp)
+  void avl_array<T,A,bW,W,bP,P,B>::sort (CMP cmp)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires<
@@ -312,6 +474,8 @@ template<class CMP>
 
   node_t * p, * next, * pos;
 
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
+
   if (size()<2)
     return;
 
@@ -326,14 +490,16 @@ template<class CMP>
     next = next->m_next;     // in order
 
     binary_search (data(p), &pos, cmp);
-    p->m_children[L] = p->m_children[R] = NULL;
-    insert_before (p, pos);
+    p->init_tree_fields ();    // Leaf (height and count too)
+    insert_before (p, pos, false);
   }
+
+  relabel_all ();            // Order labels (with bP)
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  void avl_array<T,A,bW,W,bP,P>::sort ()    // Same, but with
+  void avl_array<T,A,bW,W,bP,P,B>::sort ()  // Same, but with
 {                                           // T::operator<
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -350,10 +516,10 @@ inline
 //
 // Complexity: O(N log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 //not inline
-  void avl_array<T,A,bW,W,bP,P>::stable_sort (CMP cmp)
+  void avl_array<T,A,bW,W,bP,P,B>::stable_sort (CMP cmp)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires<
@@ -361,6 +527,7 @@ template<class CMP>
                                     const_reference> >();
 #endif
 
+  AA_ASSERT (!m_in_batch);   // See begin_batch()
   AA_ASSERT (bP);           // No P -> no stable sort
                             // Instantiate the avl_array
   if (!bP || size()<2)      // specifying true for bP (5th
@@ -381,14 +548,16 @@ template<class CMP>
 
     binary_search (data(p), &pos, cmp, i, true);
     *p->m_oldpos = i;
-    p->m_children[L] = p->m_children[R] = NULL;
-    insert_before (p, pos);
+    p->init_tree_fields ();    // Leaf (height and count too)
+    insert_before (p, pos, false);  // (keep i as label)
   }
+
+  relabel_all ();           // Order labels again
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  void avl_array<T,A,bW,W,bP,P>::stable_sort ()  // Same, but with
+  void avl_array<T,A,bW,W,bP,P,B>::stable_sort ()  // Same, but with
 {                                                // T::operator<
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -415,11 +584,11 @@ inline
 // (where N is the number of elements in this array,
 // and M is the number of elements in the donor array)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 //not inline
-  void avl_array<T,A,bW,W,bP,P>::merge
-  (typename avl_array<T,A,bW,W,bP,P>::my_class & donor,
+  void avl_array<T,A,bW,W,bP,P,B>::merge
+  (typename avl_array<T,A,bW,W,bP,P,B>::my_class & donor,
    CMP cmp)
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -432,6 +601,9 @@ template<class CMP>
                     * next, * last, * first;
   size_type n;
 
+  AA_ASSERT (!m_in_batch &&        // See begin_batch()
+             !donor.m_in_batch);
+
   if (this==&donor ||
       donor.size()==0)
     return;
@@ -480,10 +652,10 @@ template<class CMP>
   build_known_size_tree (n, first);    // Build the tree with
 }                                      // the merged list
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  void avl_array<T,A,bW,W,bP,P>::merge
-  (typename avl_array<T,A,bW,W,bP,P>::my_class & donor)
+  void avl_array<T,A,bW,W,bP,P,B>::merge
+  (typename avl_array<T,A,bW,W,bP,P,B>::my_class & donor)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -507,10 +679,10 @@ inline
 //
 // Complexity: O(N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 //not inline
-  void avl_array<T,A,bW,W,bP,P>::unique (CMP cmp)
+  void avl_array<T,A,bW,W,bP,P,B>::unique (CMP cmp)
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires<
@@ -552,9 +724,9 @@ template<class CMP>
   }
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  void avl_array<T,A,bW,W,bP,P>::unique ()
+  void avl_array<T,A,bW,W,bP,P,B>::unique ()
 {
 #ifdef BOOST_CLASS_REQUIRE
   function_requires< LessThanComparableConcept<value_type> >();
@@ -590,14 +762,14 @@ inline
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class CMP>
 //not inline
   bool
-  avl_array<T,A,bW,W,bP,P>::binary_search  // Return true iff found
-  (typename avl_array<T,A,bW,W,bP,P>::
+  avl_array<T,A,bW,W,bP,P,B>::binary_search  // Return true iff found
+  (typename avl_array<T,A,bW,W,bP,P,B>::
                  const_reference t,        // What to search
-   typename avl_array<T,A,bW,W,bP,P>::
+   typename avl_array<T,A,bW,W,bP,P,B>::
                       node_t ** pp,  // Where it is / should be
    CMP cmp,                         // Functor for '<' comparisons
    P oldpos,                       // Old position (in stable sort)
@@ -663,6 +835,69 @@ template<class CMP>
   }
 }
 
+// finger_search(): find the position where t should be
+// inserted after any equal elements (i.e. the first node
+// greater than t, or the dummy), knowing that t is not
+// lesser than the element of the node f. Instead of
+// descending from the root, climb from f while the
+// subtrees left behind can't contain the position, and
+// then descend from there. If f is NULL, the search starts
+// at the root (plain binary search).
+//
+// IMPORTANT: The whole avl_array must be in order
+// according to the comparison used. Otherwise, the result
+// will have no sense.
+//
+// Complexity: O(log d), where d is the distance from f to
+// the result (O(log N) if f is NULL)
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+template<class CMP>
+//not inline
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::finger_search
+  (typename avl_array<T,A,bW,W,bP,P,B>::const_reference t,
+   typename avl_array<T,A,bW,W,bP,P,B>::node_t * f,
+   CMP cmp)
+{
+  node_t * p, * bound;
+
+  bound = dummy ();            // Upper bound found so far
+
+  if (!f)
+    p = node_t::m_children[L];      // Root (or NULL)
+  else
+  {
+    p = f;
+
+    for (;;)
+    {
+      if (!p->m_parent->m_parent)   // Root: nowhere to climb
+        break;
+
+      if (p->m_parent->m_children[L]==p &&   // Coming from the
+          cmp (t, data(p->m_parent)))        // left of a greater
+      {                                      // node: it's the
+        bound = p->m_parent;                 // bound, and the
+        break;                               // position is
+      }                                      // below p
+
+      p = p->m_parent;
+    }
+  }
+
+  while (p)                    // Descend looking for the first
+    if (cmp (t, data(p)))      // node greater than t
+    {
+      bound = p;
+      p = p->m_children[L];
+    }
+    else
+      p = p->m_children[R];
+
+  return bound;
+}
+
 //////////////////////////////////////////////////////////////////
 
 }  // namespace mkr
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/alloc_traits.hpp
+  -----------------------
+
+  Allocator adaptation layer. With a C++11 compiler, the types
+  and the propagation rules of the allocator are taken from
+  std::allocator_traits, so that minimal allocators (like
+  std::pmr::polymorphic_allocator, which has no reference or
+  rebind members) can be used. With a C++98 compiler, they
+  are taken from the allocator itself, and all allocators of
+  the same type are supposed to be equal (as the C++98
+  standard containers do).
+
+  The user of the library doesn't need to know about these
+  classes. They are for private use only.
+
+  Available classes are:
+
+    class aa_alloc_traits     (allocator types and propagation)
+    propagate_if              (copy/move/swap allocators, or not)
+    trivially_destructible    (can destruction be skipped?)
+*/
+
+#ifndef _AVL_ARRAY_ALLOC_TRAITS_HPP_
+#define _AVL_ARRAY_ALLOC_TRAITS_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+#ifdef AA_CXX11
+
+template<class A, class N>    // Types and propagation rules of
+class aa_alloc_traits         // an allocator A, used for
+{                             // allocating nodes of type N
+  typedef std::allocator_traits<A>                 traits;
+
+  public:
+
+    typedef typename traits::value_type            value_type;
+    typedef value_type &                           reference;
+    typedef const value_type &                     const_reference;
+    typedef typename traits::pointer               pointer;
+    typedef typename traits::const_pointer         const_pointer;
+
+    typedef typename traits::template
+            rebind_alloc<N>                        node_allocator;
+
+    typedef std::allocator_traits<node_allocator>  node_traits;
+
+    enum
+    {
+      always_equal = node_traits::is_always_equal::value,
+      propagate_on_copy = node_traits::
+                  propagate_on_container_copy_assignment::value,
+      propagate_on_move = node_traits::
+                  propagate_on_container_move_assignment::value,
+      propagate_on_swap = node_traits::
+                  propagate_on_container_swap::value
+    };
+
+    static node_allocator select_on_copy (const node_allocator & a)
+    {
+      return node_traits::
+               select_on_container_copy_construction (a);
+    }
+};
+
+template<class N>             // True if the destructor of N
+class trivially_destructible  // does nothing at all
+{
+  public:
+
+    enum { value = std::is_trivially_destructible<N>::value };
+};
+
+#else
+
+template<class A, class N>    // Types and propagation rules of
+class aa_alloc_traits         // an allocator A, used for
+{                             // allocating nodes of type N
+  public:
+
+    typedef typename A::value_type                 value_type;
+    typedef typename A::reference                  reference;
+    typedef typename A::const_reference            const_reference;
+    typedef typename A::pointer                    pointer;
+    typedef typename A::const_pointer              const_pointer;
+
+    typedef typename A::template
+            rebind<N>::other                       node_allocator;
+
+    enum
+    {
+      always_equal = true,    // C++98: allocators of the same
+      propagate_on_copy = false,        // type are equal, so
+      propagate_on_move = false,        // there's nothing to
+      propagate_on_swap = false         // propagate
+    };
+
+    static node_allocator select_on_copy (const node_allocator &)
+    {
+      return node_allocator();   // (As it has allways been)
+    }
+};
+
+template<class N>             // Without C++11 traits, we can't
+class trivially_destructible  // know it, so we say no
+{
+  public:
+
+    enum { value = false };
+};
+
+#endif
+
+//////////////////////////////////////////////////////////////////
+
+template<bool B>              // Allocator propagation: the
+class propagate_if            // allocators stay where they are
+{                             // (the allocator type might not be
+  public:                     // assignable at all)
+
+    template<class X> static void copy (X &, const X &) {}
+    template<class X> static void move (X &, X &) {}
+    template<class X> static void swap (X &, X &) {}
+};
+
+template<>                    // Allocator propagation: the
+class propagate_if<true>      // allocators go with the contents
+{
+  public:
+
+    template<class X> static void copy (X & dst, const X & src)
+    {
+      dst = src;
+    }
+
+    template<class X> static void move (X & dst, X & src)
+    {
+#ifdef AA_CXX11
+      dst = std::move (src);
+#else
+      dst = src;
+#endif
+    }
+
+    template<class X> static void swap (X & a, X & b)
+    {
+      using std::swap;
+      swap (a, b);
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+}  // namespace mkr
+
+#endif
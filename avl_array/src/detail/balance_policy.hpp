@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/balance_policy.hpp
+  -------------------------
+
+  Balancing policies of avl_array (last template parameter, B):
+
+    avl_balance     heights of siblings differ in one at most
+                    (default)
+    wavl_balance    rank differences are one or two (weak AVL):
+                    at most two rotations per erase, amortized
+                    O(1) rebalancing work
+    weight_balance  sizes of siblings differ in a bounded factor
+                    (balance decided with m_count alone)
+
+  Whatever the policy, every operation keeps its complexity:
+  a climb to the root is always required for updating counts.
+*/
+
+#ifndef _AVL_ARRAY_BALANCE_POLICY_HPP_
+#define _AVL_ARRAY_BALANCE_POLICY_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+enum balance_scheme              // What the policies select
+{
+  avl_scheme,
+  wavl_scheme,
+  weight_scheme
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+//////////////////////////////////////////////////////////////////
+
+class avl_balance                // AVL: the heights of the
+{                                // subtrees of every node
+  public:                        // differ in one at most
+
+    static const detail::balance_scheme scheme =
+                                     detail::avl_scheme;
+};
+
+//////////////////////////////////////////////////////////////////
+
+class wavl_balance               // Weak AVL (Haeupler, Sen and
+{                                // Tarjan): the rank of every
+  public:                        // node (kept in m_height) is
+                                 // one or two more than its
+    static const detail::balance_scheme scheme =   // children's
+                                     detail::wavl_scheme;
+};                               // (leaves have rank one)
+
+//////////////////////////////////////////////////////////////////
+
+class weight_balance             // Weight balance (Nievergelt
+{                                // and Reingold): the weight
+  public:                        // (count+1) of a subtree is
+                                 // delta times its sibling's
+    static const detail::balance_scheme scheme =   // at most
+                                     detail::weight_scheme;
+
+    enum { delta = 3,            // Gamma chooses between single
+           gamma = 2 };          // and double rotations (these
+};                               // are Hirai and Yamamoto's)
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
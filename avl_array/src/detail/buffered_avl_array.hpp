@@ -0,0 +1,641 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/buffered_avl_array.hpp
+  -----------------------------
+
+  Class buffered_avl_array: an avl_array with a small buffer of
+  nodes at each end, for queues and sliding windows. In a plain
+  avl_array, every push or pop at an end climbs from a leaf to
+  the root, updating counts. Here, the nodes pushed at an end
+  wait in its buffer (an array of B node pointers), and pops
+  take them from there. When a buffer is full, its half that is
+  next to the tree is joined to the tree as a whole; when it is
+  empty, up to B/2 nodes are split from the tree into it. Both
+  things take O(B + log N) time, and there are at least B/2
+  cheap operations between two of them at the same end, so all
+  end operations take amortized O(1) time (as long as B is not
+  less than log2 N; the default is 64). Random access is still
+  O(log N): the buffers are checked before and after the tree.
+
+  Elements are never copied: they stay in their nodes, so
+  references remain valid until the element is popped. For
+  anything else than the operations below (iterators, insert(),
+  sort()...), array() gives the embedded avl_array, after moving
+  the buffered nodes into it.
+
+  Methods:
+
+  Default con.: empty buffered_avl_array (O(1))
+  Copy con.: copy of other buffered_avl_array (O(N))
+  Destructor (O(N))
+  Assignment operator (O(M+N))
+  swap(): interchange contents (O(B))
+  size(): number of elements (O(1))
+  empty(): true if size()==0 (O(1))
+  op.[], at(): (O(log N))
+  front(), back(): (O(1))
+  push_front(), push_back(): (amortized O(1))
+  pop_front(), pop_back(): (amortized O(1))
+  clear(): erase all (O(N))
+  flush(): move the buffered nodes into the tree (O(B + log N))
+  array(): flush() and get the embedded avl_array (O(B + log N))
+*/
+
+#ifndef _AVL_ARRAY_BUFFERED_AVL_ARRAY_HPP_
+#define _AVL_ARRAY_BUFFERED_AVL_ARRAY_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                       // avl_array with
+         class A=std::allocator<T>,     // buffered ends, for
+         std::size_t B=64>              // amortized O(1) push
+class buffered_avl_array                // and pop
+{
+  // -------------------------- TYPES ----------------------------
+
+  public:
+
+    typedef avl_array<T,A>                       avl_array_t;
+
+  private:
+
+    typedef buffered_avl_array<T,A,B>            my_class;
+    typedef typename avl_array_t::node_t         node_t;
+
+  public:
+
+    typedef T                                    value_type;
+    typedef T &                                  reference;
+    typedef const T &                            const_reference;
+    typedef T *                                  pointer;
+    typedef const T *                            const_pointer;
+    typedef std::size_t                          size_type;
+    typedef std::ptrdiff_t                       difference_type;
+
+
+  // ---------------------- PUBLIC INTERFACE ---------------------
+
+  public:
+
+    // Constructors and destructor
+    //
+    // Default con.: empty buffered_avl_array (O(1))
+    // Copy con.: copy of other buffered_avl_array (O(N))
+    // Destructor (O(N))
+
+    buffered_avl_array ();
+    buffered_avl_array (const my_class & a);
+    ~buffered_avl_array ();
+
+
+    // Container assignment and swap
+    //
+    // Assignment operator (O(M+N), M to delete + N to copy)
+    // swap(): interchange contents (O(B))
+
+    const my_class & operator= (const my_class & a);
+    void swap (my_class & a);
+
+
+    // Size
+    //
+    // size(): number of elements (O(1))
+    // empty(): true if size()==0 (O(1))
+
+    size_type size () const;
+    bool empty () const;
+
+
+    // Element access
+    //
+    // op.[], at(): (O(log N))
+    // front(), back(): (O(1))
+
+    reference operator[] (size_type n);
+    const_reference operator[] (size_type n) const;
+    reference at (size_type n);
+    const_reference at (size_type n) const;
+
+    reference front ();
+    reference back ();
+    const_reference front () const;
+    const_reference back () const;
+
+
+    // Insertion and erasure at the ends
+    //
+    // push_front(), push_back(): (amortized O(1))
+    // pop_front(), pop_back(): (amortized O(1))
+    // clear(): erase all (O(N))
+
+    void push_front (const_reference t);
+    void push_back (const_reference t);
+    void pop_front ();
+    void pop_back ();
+    void clear ();
+
+
+    // Access to the embedded avl_array
+    //
+    // flush(): move the buffered nodes into the tree
+    //                                          (O(B + log N))
+    // array(): flush() and get the avl_array (O(B + log N))
+
+    void flush ();
+    avl_array_t & array ();
+
+
+  // ------------------ PRIVATE HELPER METHODS -------------------
+
+  private:
+
+    static reference value (node_t * p);  // Element of a node
+    void flush_front (size_type n);       // n nodes of a buffer
+    void flush_back (size_type n);        // into the tree
+    void refill_front ();                 // Up to B/2 nodes of
+    void refill_back ();                  // the tree into a buffer
+
+
+  // ----------------------- DATA MEMBERS ------------------------
+
+  private:
+
+    avl_array_t m_tree;       // Elements between the buffers
+    node_t * m_front[B];      // Front buffer (a stack: the first
+    size_type m_nfront;       // element is m_front[m_nfront-1])
+    node_t * m_back[B];       // Back buffer (the last element
+    size_type m_nback;        // is m_back[m_nback-1])
+};
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// Default constructor: create an empty buffered_avl_array
+//
+// Complexity: O(1)
+
+template<class T,class A,std::size_t B>
+inline
+  buffered_avl_array<T,A,B>::buffered_avl_array ()
+  : m_nfront(0), m_nback(0)
+{
+  AA_ASSERT (B>=2);                  // Half a buffer can't be 0
+}
+
+// Copy constructor: create a buffered_avl_array with copies
+// of the elements of a (the tree is copied as a tree, and
+// the buffers as buffers)
+//
+// Complexity: O(N)
+
+template<class T,class A,std::size_t B>
+//not inline
+  buffered_avl_array<T,A,B>::buffered_avl_array
+  (const typename buffered_avl_array<T,A,B>::my_class & a)
+  : m_tree(a.m_tree), m_nfront(0), m_nback(0)
+{
+  size_type i;
+
+  try
+  {
+    for (i=0; i<a.m_nfront; i++)       // (from the one next
+      push_front (value (a.m_front[i])); // to the tree)
+
+    for (i=0; i<a.m_nback; i++)
+      push_back (value (a.m_back[i]));
+  }
+  catch (...)
+  {
+    clear ();                          // Don't leak the nodes
+    throw;                             // already buffered
+  }
+}
+
+// Destructor: destroy the elements (buffered or not)
+//
+// Complexity: O(N)
+
+template<class T,class A,std::size_t B>
+inline
+  buffered_avl_array<T,A,B>::~buffered_avl_array ()
+{
+  clear ();
+}
+
+// Assignment operator: replace the current contents with a
+// copy of the contents of a. If something throws, *this is
+// not modified.
+//
+// Complexity: O(M+N) (linear time)
+// (where M is the number of T objects to delete, and N is
+// the number of T objects to copy)
+
+template<class T,class A,std::size_t B>
+inline
+  const typename buffered_avl_array<T,A,B>::my_class &
+  buffered_avl_array<T,A,B>::operator=
+  (const typename buffered_avl_array<T,A,B>::my_class & a)
+{
+  if (&a != this)
+  {
+    my_class tmp(a);
+    swap (tmp);
+  }
+
+  return *this;
+}
+
+// swap(): interchange the contents of two buffered_avl_array
+// objects. The trees are swapped in O(1) time, and the
+// buffers (just pointers) in O(B). References keep referring
+// the same elements (now in the other container).
+//
+// Complexity: O(B)
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::swap
+  (typename buffered_avl_array<T,A,B>::my_class & a)
+{
+  if (&a == this) return;
+
+  m_tree.swap (a.m_tree);            // (first, as it may throw)
+
+  std::swap_ranges (m_front, m_front + (m_nfront>a.m_nfront ?
+                                        m_nfront:a.m_nfront),
+                    a.m_front);
+  std::swap_ranges (m_back, m_back + (m_nback>a.m_nback ?
+                                      m_nback:a.m_nback),
+                    a.m_back);
+  std::swap (m_nfront, a.m_nfront);
+  std::swap (m_nback, a.m_nback);
+}
+
+// size(): return the number of elements
+//
+// Complexity: O(1)
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::size_type
+  buffered_avl_array<T,A,B>::size () const
+{
+  return m_nfront + m_tree.size () + m_nback;
+}
+
+// empty(): return true if there are no elements
+//
+// Complexity: O(1)
+
+template<class T,class A,std::size_t B>
+inline
+  bool
+  buffered_avl_array<T,A,B>::empty () const
+{
+  return !size ();
+}
+
+// Index operator: return (by reference) the n-th element.
+// The front buffer, the tree and the back buffer are tried
+// in this order.
+//
+// Complexity: O(log N)
+
+template<class T,class A,std::size_t B>
+//not inline
+  typename buffered_avl_array<T,A,B>::reference
+  buffered_avl_array<T,A,B>::operator[]
+  (typename buffered_avl_array<T,A,B>::size_type n)
+{
+  if (n<m_nfront)
+    return value (m_front[m_nfront-1-n]);
+
+  n -= m_nfront;
+
+  if (n<m_tree.size ())
+    return m_tree[n];
+
+  n -= m_tree.size ();
+  AA_ASSERT (n<m_nback);
+  return value (m_back[n]);
+}
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::const_reference
+  buffered_avl_array<T,A,B>::operator[]
+  (typename buffered_avl_array<T,A,B>::size_type n) const
+{
+  return const_cast<my_class*>(this)->operator[] (n);
+}
+
+// at(): like operator [], but throw index_out_of_bounds if
+// n is not less than size()
+//
+// Complexity: O(log N)
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::reference
+  buffered_avl_array<T,A,B>::at
+  (typename buffered_avl_array<T,A,B>::size_type n)
+{
+  AA_ASSERT_EXC (n<size (), index_out_of_bounds());
+  return (*this)[n];
+}
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::const_reference
+  buffered_avl_array<T,A,B>::at
+  (typename buffered_avl_array<T,A,B>::size_type n) const
+{
+  AA_ASSERT_EXC (n<size (), index_out_of_bounds());
+  return (*this)[n];
+}
+
+// front(), back(): return (by reference) the first or the
+// last element
+//
+// Complexity: O(1)
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::reference
+  buffered_avl_array<T,A,B>::front ()
+{
+  if (m_nfront) return value (m_front[m_nfront-1]);
+  if (!m_tree.empty ()) return m_tree.front ();
+  AA_ASSERT (m_nback);
+  return value (m_back[0]);
+}
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::reference
+  buffered_avl_array<T,A,B>::back ()
+{
+  if (m_nback) return value (m_back[m_nback-1]);
+  if (!m_tree.empty ()) return m_tree.back ();
+  AA_ASSERT (m_nfront);
+  return value (m_front[0]);
+}
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::const_reference
+  buffered_avl_array<T,A,B>::front () const
+{
+  return const_cast<my_class*>(this)->front ();
+}
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::const_reference
+  buffered_avl_array<T,A,B>::back () const
+{
+  return const_cast<my_class*>(this)->back ();
+}
+
+// push_front(), push_back(): insert a copy of t at the
+// beginning or at the end. The new node goes to the buffer
+// of that end; if it is full, half of it is joined to the
+// tree first. If the copy constructor throws, nothing is
+// inserted (though the buffer might have been flushed).
+//
+// Complexity: amortized O(1) (O(B + log N) worst case)
+
+template<class T,class A,std::size_t B>
+inline
+  void
+  buffered_avl_array<T,A,B>::push_front
+  (typename buffered_avl_array<T,A,B>::const_reference t)
+{
+  if (m_nfront==B)
+    flush_front (B/2);
+
+  m_front[m_nfront] = m_tree.new_node (&t);
+  m_nfront ++;
+}
+
+template<class T,class A,std::size_t B>
+inline
+  void
+  buffered_avl_array<T,A,B>::push_back
+  (typename buffered_avl_array<T,A,B>::const_reference t)
+{
+  if (m_nback==B)
+    flush_back (B/2);
+
+  m_back[m_nback] = m_tree.new_node (&t);
+  m_nback ++;
+}
+
+// pop_front(), pop_back(): erase the first or the last
+// element. If the buffer of that end is empty, it is
+// refilled with up to B/2 nodes of the tree first. If the
+// tree is empty too, the element is at the far end of the
+// other buffer (which holds B elements at most).
+//
+// Complexity: amortized O(1) (O(B + log N) worst case)
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::pop_front ()
+{
+  node_t * p;
+
+  AA_ASSERT_EXC (!empty (), invalid_op_with_end());
+
+  if (!m_nfront)
+    refill_front ();
+
+  if (m_nfront)
+    p = m_front[--m_nfront];
+  else
+  {
+    p = m_back[0];
+    std::copy (m_back + 1, m_back + m_nback, m_back);
+    m_nback --;
+  }
+
+  m_tree.delete_node (p);
+}
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::pop_back ()
+{
+  node_t * p;
+
+  AA_ASSERT_EXC (!empty (), invalid_op_with_end());
+
+  if (!m_nback)
+    refill_back ();
+
+  if (m_nback)
+    p = m_back[--m_nback];
+  else
+  {
+    p = m_front[0];
+    std::copy (m_front + 1, m_front + m_nfront, m_front);
+    m_nfront --;
+  }
+
+  m_tree.delete_node (p);
+}
+
+// clear(): erase every element
+//
+// Complexity: O(N)
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::clear ()
+{
+  while (m_nfront)
+    m_tree.delete_node (m_front[--m_nfront]);
+
+  while (m_nback)
+    m_tree.delete_node (m_back[--m_nback]);
+
+  m_tree.clear ();
+}
+
+// flush(): move all the buffered nodes into the tree, so
+// that it holds the whole sequence
+//
+// Complexity: O(B + log N)
+
+template<class T,class A,std::size_t B>
+inline
+  void
+  buffered_avl_array<T,A,B>::flush ()
+{
+  if (m_nfront) flush_front (m_nfront);
+  if (m_nback) flush_back (m_nback);
+}
+
+// array(): get (by reference) the embedded avl_array, once
+// it holds the whole sequence (see flush()). It can be used
+// in any way; the buffers are empty until the next push or
+// pop.
+//
+// Complexity: O(B + log N)
+
+template<class T,class A,std::size_t B>
+inline
+  typename buffered_avl_array<T,A,B>::avl_array_t &
+  buffered_avl_array<T,A,B>::array ()
+{
+  flush ();
+  return m_tree;
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// value(): get (by reference) the element of a buffered node
+//
+// Complexity: O(1)
+
+template<class T,class A,std::size_t B>
+inline //static
+  typename buffered_avl_array<T,A,B>::reference
+  buffered_avl_array<T,A,B>::value
+  (typename buffered_avl_array<T,A,B>::node_t * p)
+{
+  return avl_array_t::unlinked_data (p);
+}
+
+// flush_front(), flush_back(): join to the tree the n nodes
+// of a buffer that are next to it, and shift the rest
+//
+// Complexity: O(B + log N)
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::flush_front
+  (typename buffered_avl_array<T,A,B>::size_type n)
+{
+  AA_ASSERT (n>0 && n<=m_nfront);
+
+  std::reverse (m_front, m_front + n);      // (in sequence order)
+  m_tree.append_nodes (m_front, n, true);
+  std::copy (m_front + n, m_front + m_nfront, m_front);
+  m_nfront -= n;
+}
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::flush_back
+  (typename buffered_avl_array<T,A,B>::size_type n)
+{
+  AA_ASSERT (n>0 && n<=m_nback);
+
+  m_tree.append_nodes (m_back, n, false);
+  std::copy (m_back + n, m_back + m_nback, m_back);
+  m_nback -= n;
+}
+
+// refill_front(), refill_back(): split up to B/2 nodes from
+// an end of the tree into the (empty) buffer of that end
+//
+// Complexity: O(B + log N)
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::refill_front ()
+{
+  size_type n;
+
+  AA_ASSERT (!m_nfront);
+
+  n = m_tree.size () < B/2 ? m_tree.size () : B/2;
+  m_tree.detach_nodes (m_front, n, true);
+  std::reverse (m_front, m_front + n);      // (as a stack)
+  m_nfront = n;
+}
+
+template<class T,class A,std::size_t B>
+//not inline
+  void
+  buffered_avl_array<T,A,B>::refill_back ()
+{
+  size_type n;
+
+  AA_ASSERT (!m_nback);
+
+  n = m_tree.size () < B/2 ? m_tree.size () : B/2;
+  m_tree.detach_nodes (m_back, n, false);
+  m_nback = n;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
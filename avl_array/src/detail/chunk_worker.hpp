@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/chunk_worker.hpp
+  -----------------------
+
+  Functors used by the parallel methods. A range is cut in k
+  chunks, and every chunk is processed by a single thread. Jobs
+  are called with the number of a chunk. Workers are called
+  with first() for its first element and next() for the rest.
+  Different chunks might be processed concurrently, so they
+  keep a separate state for every chunk.
+
+  The user of the library doesn't need to know about these
+  functors. They are for private use only.
+
+  Available jobs and workers are:
+
+    class chunk_job        (call a worker for every node of the
+                            chunk)
+    build_job              (construct the nodes of the chunk,
+                            copying them from a data provider)
+    for_each_worker        (call f for every element)
+    reduce_worker          (combine the elements of every chunk
+                            with op, keeping a partial result
+                            per chunk)
+*/
+
+#ifndef _AVL_ARRAY_CHUNK_WORKER_HPP_
+#define _AVL_ARRAY_CHUNK_WORKER_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+template<class AA, class NP, class WK>  // Job used for traversing
+class chunk_job                         // a range, chunk by chunk
+{
+  private:
+
+    WK & worker;                     // Shared by all threads
+    const std::vector<NP> & bounds;  // k+1 chunk boundaries
+
+  public:
+
+    chunk_job (WK & w, const std::vector<NP> & b)
+      : worker(w), bounds(b) {}
+
+    void operator() (std::size_t c)
+    {
+      AA::run_chunk (worker, c, bounds[c], bounds[c+1]);
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class AA, class NP,            // Job used for building
+         class DP, class IT>            // new nodes, chunk by
+class build_job                         // chunk
+{
+  private:
+
+    AA * owner;                           // Allocator owner
+    const std::vector<IT> & starts;       // Where every chunk
+    const std::vector<std::size_t> & counts; // starts, and its
+                                          // number of elements
+    std::vector<NP> & firsts;             // Resulting lists
+    std::vector<NP> & lasts;              // (one per chunk)
+
+  public:
+
+    build_job (AA * a,
+               const std::vector<IT> & s,
+               const std::vector<std::size_t> & n,
+               std::vector<NP> & f,
+               std::vector<NP> & l)
+      : owner(a), starts(s), counts(n), firsts(f), lasts(l) {}
+
+    void operator() (std::size_t c)
+    {
+      DP dp(starts[c]);
+      NP first, last;
+                                     // Publish the list only
+      owner->construct_nodes_list    // when it is complete
+               (first, last, counts[c], dp);
+      firsts[c] = first;
+      lasts[c] = last;
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class Ref, class F>  // Function object used for calling
+class for_each_worker         // f for every element
+{
+  private:
+
+    F & f;                   // Shared by all threads
+
+  public:
+
+    for_each_worker (F & func) : f(func) {}
+
+    void prepare (std::size_t) {}
+
+    void first (std::size_t, Ref x) { f (x); }
+    void next (std::size_t, Ref x)  { f (x); }
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class Ref, class V, class OP>  // Function object used for
+class reduce_worker                     // reducing every chunk to
+{                                       // a partial result
+  private:
+
+    OP & op;                 // Shared by all threads
+
+  public:
+
+    std::vector<V> partial;  // One result per chunk
+
+    reduce_worker (OP & o) : op(o) {}
+
+    void prepare (std::size_t k) { partial.resize (k); }
+
+    void first (std::size_t c, Ref x) { partial[c] = V(x); }
+    void next (std::size_t c, Ref x)
+    {
+      partial[c] = op (partial[c], x);
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+}  // namespace mkr
+
+#endif
@@ -24,6 +24,10 @@
     iter_aa_data_provider     (use an avl_array of the same type)
     range_data_provider       (same as iter_, but stop at "to")
     copy_data_provider        (use allways the same prototype)
+    batch_data_provider       (use the values of (index,value)
+                               pairs, stop at "to")
+    stream_data_provider      (read objects from a stream with
+                               a codec)
 */
 
 #ifndef _AVL_ARRAY_DATA_PROVIDER_HPP_
@@ -103,9 +107,10 @@ class iter_aa_data_provider            // copying an avl_array (or
     Ptr operator() ()
     {
       Ptr p=&*it;                      // Return current element,
-      last_width = & it.npsv_width (); // store a pointer to its
-      ++ it;                           // NPSV width, and
-      return p;                        // advance
+      if (bW)                          // store a pointer to its
+        last_width = & it.npsv_width (); // NPSV width (if any),
+      ++ it;                           // and advance
+      return p;
     }
 
     bool has_npsv () { return bW; }
@@ -164,6 +169,69 @@ class copy_data_provider     // collections of copies of a given
     template<class W> void get_npsv_width (W &) {}
 };
 
+//////////////////////////////////////////////////////////////////
+
+template<class Ptr, class IT> // Function object used for copying
+class batch_data_provider     // the values of a sequence of
+{                             // (index,value) pairs
+#ifdef BOOST_CLASS_REQUIRE
+  BOOST_CLASS_REQUIRE (IT, boost, InputIteratorConcept);
+#endif
+
+  private:
+
+    IT it;                   // State: current position
+    IT end;                  // Limit (to)
+
+  public:
+
+    batch_data_provider (const IT & from,
+                         const IT & to) : it(from), end(to) {}
+
+    Ptr operator() ()
+    {
+      if (it==end)
+        return NULL;
+
+      Ptr p=&it->second;  // Return current value and advance
+      ++ it;
+      return p;
+    }
+
+    bool has_npsv () { return false; }
+    template<class W> void get_npsv_width (W &) {}
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class Ptr, class T,
+                    class C>  // Function object used for reading
+class stream_data_provider    // objects saved in a stream (see
+{                             // avl_array::load())
+  private:
+
+    std::istream & is;       // Source
+    C & codec;               // How to read every object
+    T t;                     // Last object read
+
+  public:
+
+    stream_data_provider (std::istream & s, C & c) : is(s),
+                                                     codec(c),
+                                                     t() {}
+
+    Ptr operator() ()
+    {
+      codec.load (is, t);    // Read next object (or throw if
+                             // the stream couldn't provide it)
+      AA_ASSERT_EXC (!is.fail (), invalid_stream_data());
+      return &t;
+    }
+
+    bool has_npsv () { return false; }
+    template<class W> void get_npsv_width (W &) {}
+};
+
 //////////////////////////////////////////////////////////////////
 
   }  // namespace detail
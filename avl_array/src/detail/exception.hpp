@@ -16,6 +16,10 @@
     index_out_of_bounds      (op.[], op.(), move ...)
     invalid_op_with_end      (move, erase, dereference ...)
     lesser_and_greater       (sort, insert_sorted ...)
+    allocator_mismatch       (swap, move, splice ...)
+    capacity_exceeded        (static_avl_array: insert, resize ...)
+    hook_already_linked      (intrusive_avl_array: insert ...)
+    invalid_stream_data      (load)
 */
 
 #ifndef _AVL_ARRAY_EXCEPTION_HPP_
@@ -71,6 +75,46 @@ class lesser_and_greater : public virtual std::exception
     { return "Lesser and greater at the same time"; }
 };
 
+//////////////////////////////////////////////////////////////////
+
+class allocator_mismatch : public virtual std::exception
+{
+  public:
+    virtual ~allocator_mismatch() throw() { }
+    virtual const char* what() const throw()
+    { return "Nodes can't be shared by different allocators"; }
+};
+
+//////////////////////////////////////////////////////////////////
+
+class capacity_exceeded : public virtual std::exception
+{
+  public:
+    virtual ~capacity_exceeded() throw() { }
+    virtual const char* what() const throw()
+    { return "Fixed capacity exceeded"; }
+};
+
+//////////////////////////////////////////////////////////////////
+
+class hook_already_linked : public virtual std::exception
+{
+  public:
+    virtual ~hook_already_linked() throw() { }
+    virtual const char* what() const throw()
+    { return "Object already linked in an intrusive_avl_array"; }
+};
+
+//////////////////////////////////////////////////////////////////
+
+class invalid_stream_data : public virtual std::exception
+{
+  public:
+    virtual ~invalid_stream_data() throw() { }
+    virtual const char* what() const throw()
+    { return "Stream data is not a saved avl_array of this type"; }
+};
+
 //////////////////////////////////////////////////////////////////
 
   }  // namespace detail
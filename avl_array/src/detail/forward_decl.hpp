@@ -25,36 +25,76 @@ namespace mkr  // Public namespace
 
   template<class T, class A,
            bool bW, class W,
-           bool bP, class P>         // The only visible class
-  class avl_array;                   // is avl_array<T,A,bW,W,bP,P>
+           bool bP, class P,         // The only visible class
+           class B>                  // is avl_array<T,A,bW,W,bP,P,B>
+  class avl_array;
+
+  class avl_balance;                 // Balancing policies for
+  class wavl_balance;                // avl_array (parameter B)
+  class weight_balance;
+
+  template<class T, std::size_t C,
+           bool bW, class W,
+           bool bP, class P>         // Fixed capacity avl_array
+  class static_avl_array;            // (with inline nodes)
+
+  template<class T, std::size_t N,
+           class A, std::size_t L>   // Inline buffer or avl_array
+  class small_avl_array;             // (hybrid)
+
+  template<class T, class W>         // Read-only contiguous
+  class frozen_avl_view;             // snapshot
+
+  template<class E>                  // Interval width (NPSV)
+  class npsv_interval;               // for interval queries
+
+  template<class T>                  // Default codec of save()
+  class raw_codec;                   // and load()
+
+  template<class T, class A,
+           std::size_t B>            // avl_array with buffered
+  class buffered_avl_array;          // ends (for queues)
+
+  template<class T, class Tag,
+           bool bW, class W,
+           bool bP, class P>         // Intrusive avl_array and
+  class intrusive_avl_array;         // the base class of its
+                                     // elements
+  template<class T, class Tag,
+           bool bW, class W,
+           bool bP, class P>
+  class avl_array_hook;
 
   namespace detail  // Private nested namespace mkr::detail
   {
 
     template<class T, class A,
              bool bW, class W,
-             bool bP, class P>            // Links and counters
+             bool bP, class P,            // Links and counters
+             class B>
     class avl_array_node_tree_fields;     // of a tree node
 
     template<class T, class A,
              bool bW, class W,
-             bool bP, class P>            // A tree node, including
+             bool bP, class P,            // A tree node, including
+             class B>
     class avl_array_node;                 // its payload value_type
 
     template<class T, class A,
              bool bW, class W,
-             bool bP, class P>            // A list of nodes to
+             bool bP, class P,            // A list of nodes to
+             class B>
     class rollback_list;                  // complete or delete
 
     template<class T, class A,
              bool bW, class W,
-             bool bP, class P,
+             bool bP, class P, class B,
              class Ref, class Ptr>
     class avl_array_iterator;             // Normal iterator
 
     template<class T, class A,
              bool bW, class W,
-             bool bP, class P,
+             bool bP, class P, class B,
              class Ref, class Ptr>
     class avl_array_rev_iter;             // Reverse iterator
 
@@ -62,6 +102,38 @@ namespace mkr  // Public namespace
     class index_out_of_bounds;
     class invalid_op_with_end;            // Exceptions
     class lesser_and_greater;
+    class allocator_mismatch;
+    class capacity_exceeded;
+    class hook_already_linked;
+    class invalid_stream_data;
+
+    template<class A, class N>              // Allocator types and
+    class aa_alloc_traits;                  // propagation rules
+    template<bool B>
+    class propagate_if;
+    template<class N>
+    class trivially_destructible;
+
+    class static_pool;                      // Inline nodes for
+    template<class N>                       // static_avl_array
+    union static_pool_block;
+    template<class N, std::size_t C>
+    class static_pool_storage;
+    template<class T>
+    class static_allocator;
+
+    template<class T, std::size_t N,        // small_avl_array
+             class AA>
+    union small_storage;
+    template<class T, class Ref, class Ptr,
+             class TIT>
+    class small_avl_array_iterator;
+
+    template<class W>                       // frozen_avl_view
+    class npsv_default_cmp;
+
+    template<class T, class Tag>            // Pseudo-allocator of
+    class intrusive_allocator;              // intrusive_avl_array
 
     template<class Ptr>
     class null_data_provider;
@@ -74,6 +146,18 @@ namespace mkr  // Public namespace
     class range_data_provider;              // interface
     template<class Ptr>
     class copy_data_provider;
+    template<class Ptr, class IT>
+    class batch_data_provider;
+
+    template<class AA, class NP, class WK>
+    class chunk_job;
+    template<class AA, class NP,            // Functors used by
+             class DP, class IT>            // the parallel
+    class build_job;                        // methods
+    template<class Ref, class F>
+    class for_each_worker;
+    template<class Ref, class V, class OP>
+    class reduce_worker;
 
   }  // namespace detail
 
@@ -0,0 +1,540 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/frozen_avl_view.hpp
+  --------------------------
+
+  Class frozen_avl_view: a read-only snapshot of an avl_array,
+  laid out in contiguous memory for build-once, query-many
+  phases. The elements are copied to a flat array, so that
+  indexing and iterating take O(1) time with no pointer
+  chasing. The NPSV widths are accumulated in prefix sums, and
+  these are also stored in Eytzinger (BFS) order, where the
+  first levels of the implicit search tree share a few cache
+  lines, so that npsv_at_pos() is a branch-free descent that
+  can prefetch the next levels.
+
+  Methods:
+
+  Default con.: empty view (O(1))
+  From avl_array con.: snapshot of an avl_array (O(N))
+  refresh(): re-take the snapshot from a position (O(N))
+  size(), empty(): (O(1))
+  begin(), end(), op.[], at(), front(), back(): (O(1))
+  npsv_width(): total width (O(1))
+  npsv_width(n): width of the n-th element (O(1))
+  npsv_pos_of(n): position of the n-th element (O(1))
+  npsv_at_pos(): element at a position (O(log N), branch-free)
+*/
+
+#ifndef _AVL_ARRAY_FROZEN_AVL_VIEW_HPP_
+#define _AVL_ARRAY_FROZEN_AVL_VIEW_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+template<class W>              // Three-way comparison with the
+class npsv_default_cmp         // operators < and == of W (the
+{                              // ones used by avl_array when no
+  public:                      // functor is given)
+
+    int operator() (const W & a, const W & b) const
+    {
+      return a<b ? -1 : (a==b ? 0 : 1);
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                       // Read-only contiguous
+         class W=std::size_t>           // snapshot of an avl_array
+class frozen_avl_view
+{
+  // -------------------------- TYPES ----------------------------
+
+  private:
+
+    typedef frozen_avl_view<T,W>                 my_class;
+
+  public:
+
+    typedef T                                    value_type;
+    typedef const T &                            const_reference;
+    typedef const T *                            const_pointer;
+    typedef const T *                            const_iterator;
+    typedef std::size_t                          size_type;
+    typedef std::ptrdiff_t                       difference_type;
+
+
+  // ---------------------- PUBLIC INTERFACE ---------------------
+
+  public:
+
+    // Constructors (copy, assignment and destructor are the
+    // default ones)
+    //
+    // Default con.: empty view (O(1))
+    // From avl_array con.: snapshot of an avl_array (O(N))
+
+    frozen_avl_view ();
+
+    template<class A, bool bW, bool bP, class P, class B>
+    explicit frozen_avl_view (const avl_array<T,A,bW,W,bP,P,B> & a);
+
+
+    // Rebuild
+    //
+    // refresh(): re-take the snapshot of a, supposing that only
+    //            elements from the position first onwards have
+    //            changed (O(N-first) T copies + O(N) layout)
+
+    template<class A, bool bW, bool bP, class P, class B>
+    void refresh (const avl_array<T,A,bW,W,bP,P,B> & a,
+                  size_type first=0);
+
+
+    // Size and element access
+    //
+    // size(), empty(): (O(1))
+    // begin(), end(), op.[], at(), front(), back(): (O(1))
+
+    size_type size () const;
+    bool empty () const;
+
+    const_iterator begin () const;
+    const_iterator end () const;
+    const_reference operator[] (size_type n) const;
+    const_reference at (size_type n) const;
+    const_reference front () const;
+    const_reference back () const;
+
+
+    // NPSV (if the source had no widths, every element has
+    // width 1)
+    //
+    // npsv_width(): total width (O(1))
+    // npsv_width(n): width of the n-th element (O(1))
+    // npsv_pos_of(n): position of the n-th element (O(1))
+    // npsv_at_pos(): element at a position (O(log N))
+
+    const W & npsv_width () const;
+    W npsv_width (size_type n) const;
+    const W & npsv_pos_of (size_type n) const;
+
+    const_iterator npsv_at_pos (W pos, bool first=true) const;
+
+    template<class CMP>
+    const_iterator npsv_at_pos (W pos, CMP cmp,
+                                bool first=true) const;
+
+
+  // ------------------ PRIVATE HELPER METHODS -------------------
+
+  private:
+
+    void build_layout ();                 // Fill the Eytzinger
+    size_type build_layout (size_type i,  // arrays (in-order
+                            size_type k); // traversal)
+
+    template<class CMP>
+    size_type search (const W & pos,      // First prefix sum >=
+                      bool strict,        // (or > if strict) pos
+                      CMP cmp) const;
+
+
+  // ----------------------- DATA MEMBERS ------------------------
+
+  private:
+
+    std::vector<T> m_data;          // The elements
+    std::vector<W> m_sums;          // m_sums[i]: position of i-th
+                                    // (the last one is the total)
+    std::vector<W> m_eytz;          // m_sums in Eytzinger order
+};                                  // (1-based)
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// Default constructor: create an empty view
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  frozen_avl_view<T,W>::frozen_avl_view ()
+  : m_sums(1, W(0))
+{
+  build_layout ();
+}
+
+// From avl_array constructor: create a view with copies of
+// the elements of a, and their NPSV widths. If the widths
+// sums of a are out of date, they are not updated (only the
+// widths themselves are read).
+//
+// Complexity: O(N)
+
+template<class T,class W>
+template<class A, bool bW, bool bP, class P, class B>
+inline
+  frozen_avl_view<T,W>::frozen_avl_view
+  (const avl_array<T,A,bW,W,bP,P,B> & a)
+{
+  refresh (a, 0);
+}
+
+// refresh(): take the snapshot of a again. The elements
+// before the position first (and their widths) are supposed
+// not to have changed, so that they are neither copied nor
+// accumulated again. The Eytzinger layout is always rebuilt,
+// but it only copies W values.
+//
+// Complexity: O(N-first) T copies and O(N) W copies
+
+template<class T,class W>
+template<class A, bool bW, bool bP, class P, class B>
+//not inline
+  void
+  frozen_avl_view<T,W>::refresh
+  (const avl_array<T,A,bW,W,bP,P,B> & a,
+   typename frozen_avl_view<T,W>::size_type first)
+{
+  typename avl_array<T,A,bW,W,bP,P,B>::const_iterator it;
+  W w;
+
+  AA_ASSERT (first<=m_data.size () && first<=a.size ());
+
+  if (first>m_data.size () || first>a.size ())
+    first = 0;
+
+  it = a.begin () + first;
+
+  m_data.erase (m_data.begin () + first, m_data.end ());
+  m_data.insert (m_data.end (), it, a.end ());
+
+  m_sums.resize (first + 1, W(0));         // m_sums[first] is
+  m_sums.reserve (a.size () + 1);          // still valid
+
+  for (w=m_sums.back (); it!=a.end (); ++it)
+  {
+    if (bW)
+      w += a.npsv_width (it);
+    else
+      w += W(1);
+
+    m_sums.push_back (w);
+  }
+
+  build_layout ();
+}
+
+// size(): return the number of elements
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::size_type
+  frozen_avl_view<T,W>::size () const
+{
+  return m_data.size ();
+}
+
+// empty(): return true if there are no elements
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  bool
+  frozen_avl_view<T,W>::empty () const
+{
+  return m_data.empty ();
+}
+
+// begin(), end(): return a pointer to the first element, or
+// to the position after the last one
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_iterator
+  frozen_avl_view<T,W>::begin () const
+{
+  return m_data.empty () ? NULL : &m_data[0];
+}
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_iterator
+  frozen_avl_view<T,W>::end () const
+{
+  return begin () + m_data.size ();
+}
+
+// Operator []: return the n-th element
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_reference
+  frozen_avl_view<T,W>::operator[]
+  (typename frozen_avl_view<T,W>::size_type n) const
+{
+  AA_ASSERT (n<m_data.size ());
+  return m_data[n];
+}
+
+// at(): like operator [], but throw index_out_of_bounds if
+// n is not less than size()
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_reference
+  frozen_avl_view<T,W>::at
+  (typename frozen_avl_view<T,W>::size_type n) const
+{
+  AA_ASSERT_EXC (n<m_data.size (), index_out_of_bounds());
+  return m_data[n];
+}
+
+// front(), back(): return the first or the last element
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_reference
+  frozen_avl_view<T,W>::front () const
+{
+  AA_ASSERT (!m_data.empty ());
+  return m_data.front ();
+}
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_reference
+  frozen_avl_view<T,W>::back () const
+{
+  AA_ASSERT (!m_data.empty ());
+  return m_data.back ();
+}
+
+// npsv_width(): return the total width (the position of end
+// in the alternative sequence)
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  const W &
+  frozen_avl_view<T,W>::npsv_width () const
+{
+  return m_sums.back ();
+}
+
+// npsv_width(): return the width of the n-th element
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  W
+  frozen_avl_view<T,W>::npsv_width
+  (typename frozen_avl_view<T,W>::size_type n) const
+{
+  W w;
+
+  AA_ASSERT (n<m_data.size ());
+
+  w = m_sums[n+1];
+  w -= m_sums[n];
+  return w;
+}
+
+// npsv_pos_of(): return the position of the n-th element in
+// the alternative sequence (n==size() gives the total width)
+//
+// Complexity: O(1)
+
+template<class T,class W>
+inline
+  const W &
+  frozen_avl_view<T,W>::npsv_pos_of
+  (typename frozen_avl_view<T,W>::size_type n) const
+{
+  AA_ASSERT (n<m_sums.size ());
+  return m_sums[n];
+}
+
+// npsv_at_pos(): find the element that stands in the
+// position pos of the alternative sequence, with the same
+// rules as avl_array::npsv_at_pos() (including zero-width
+// elements, and the first parameter). Return end() if there
+// is none.
+//
+// Complexity: O(log N)
+
+template<class T,class W>
+inline
+  typename frozen_avl_view<T,W>::const_iterator
+  frozen_avl_view<T,W>::npsv_at_pos (W pos, bool first) const
+{
+  return npsv_at_pos (pos, detail::npsv_default_cmp<W>(), first);
+}
+
+// npsv_at_pos(): idem, but using a functor instead of the
+// operators of W (see avl_array::npsv_at_pos()).
+// Elements in [S(i),S(i+1)) stand in the position pos,
+// where S are the prefix sums. With first==true, the result
+// is the first i such that S(i)==pos, or the one before
+// the first i such that S(i)>pos (so that zero-width
+// elements in pos come before the one covering it). With
+// first==false, it is the one before the first i such that
+// S(i)>pos (zero-width elements are skipped).
+//
+// Complexity: O(log N)
+
+template<class T,class W>
+template<class CMP>
+//not inline
+  typename frozen_avl_view<T,W>::const_iterator
+  frozen_avl_view<T,W>::npsv_at_pos
+  (W pos, CMP cmp, bool first) const
+{
+  size_type i;
+
+  if (m_data.empty () || cmp(pos,W(0))<0)     // Out of bounds
+    return end ();
+
+  i = search (pos, !first, cmp);
+
+  if (i==m_sums.size ())                      // pos >= total
+    return end ();
+
+  if (first && cmp(m_sums[i],pos)==0)         // S(i)==pos
+    return begin () + i;     // (i==size() gives end() here)
+
+  return begin () + (i-1);   // S(i)>pos, and S(0)==0 <= pos
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// build_layout(): copy m_sums to m_eytz in Eytzinger order,
+// with the slot 1 as root, and the children of k in 2k and
+// 2k+1 (slot 0 is unused).
+//
+// Complexity: O(N)
+
+template<class T,class W>
+inline
+  void
+  frozen_avl_view<T,W>::build_layout ()
+{
+  m_eytz.resize (m_sums.size () + 1, W(0));
+  build_layout (0, 1);
+}
+
+template<class T,class W>
+//not inline
+  typename frozen_avl_view<T,W>::size_type
+  frozen_avl_view<T,W>::build_layout
+  (typename frozen_avl_view<T,W>::size_type i,
+   typename frozen_avl_view<T,W>::size_type k)
+{
+  if (k<=m_sums.size ())             // In-order traversal of the
+  {                                  // implicit tree: the k-th
+    i = build_layout (i, 2*k);       // slot gets the i-th sum
+    m_eytz[k] = m_sums[i++];
+    i = build_layout (i, 2*k+1);
+  }
+
+  return i;
+}
+
+// search(): descend the Eytzinger layout looking for the
+// first prefix sum that is >= pos (or > pos if strict), and
+// return its index in m_sums (m_sums.size() if none). No
+// branch depends on the data: every step goes to 2k or
+// 2k+1 depending on a comparison result, and the
+// descendants four levels below (16 consecutive slots) are
+// prefetched. At the end, the trailing 1's of k (the right
+// turns after the last left one) are dropped, leaving the
+// slot where the last left turn was taken. Its index in
+// m_sums is computed from the slot number: in the perfect
+// tree that completes the last level (depth h), the slot k
+// at depth d has the in-order index (2(k-2^d)+1)*2^(h-d)-1,
+// and the missing leaves that precede it are subtracted.
+//
+// Complexity: O(log N)
+
+template<class T,class W>
+template<class CMP>
+//not inline
+  typename frozen_avl_view<T,W>::size_type
+  frozen_avl_view<T,W>::search
+  (const W & pos, bool strict, CMP cmp) const
+{
+  const W * e;
+  size_type k, m, h, d, i, n;
+
+  e = &m_eytz[0];
+  m = m_sums.size ();
+
+  for (k=1; k<=m; )
+  {
+#ifdef __GNUC__
+    if (16*k<=m)
+      __builtin_prefetch (e + 16*k);
+#endif
+    k = 2*k + (strict ? cmp(e[k],pos)<=0 : cmp(e[k],pos)<0);
+  }
+
+  while (k&1)         // Drop the right turns
+    k >>= 1;
+  k >>= 1;            // and the last left one
+
+  if (!k)
+    return m;                        // Not found
+
+  for (h=0; (size_type(2)<<h)<=m; h++) ;  // Last level
+  for (d=0; (size_type(2)<<d)<=k; d++) ;  // Level of k
+
+  i = ((2*(k-(size_type(1)<<d))+1) << (h-d)) - 1;
+  n = (i+1) / 2;                     // Leaves before it, and
+  m = m - (size_type(1)<<h) + 1;     // leaves actually there
+
+  return n>m ? i-(n-m) : i;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
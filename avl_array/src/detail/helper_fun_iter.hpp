@@ -44,11 +44,11 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::next
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::next
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   AA_ASSERT (p);       // NULL pointer dereference
   return p->m_next;
@@ -58,11 +58,11 @@ inline //static
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::prev
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::prev
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   AA_ASSERT (p);       // NULL pointer dereference
   return p->m_prev;
@@ -73,18 +73,18 @@ inline //static
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::reference
-  avl_array<T,A,bW,W,bP,P>::data
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  typename avl_array<T,A,bW,W,bP,P,B>::reference
+  avl_array<T,A,bW,W,bP,P,B>::data
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   AA_ASSERT (p);            // NULL pointer dereference
 
   AA_ASSERT_EXC (p->m_parent,
                  invalid_op_with_end());   // end() has no data
 
-  return (static_cast<payload_node_t*>(p))->m_data;
+  return payload_node_t::payload (p);
 }
 
 // npsv_width(): Get a const reference to the NPSV width (type W)
@@ -92,16 +92,16 @@ inline //static
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
   const W &
-  avl_array<T,A,bW,W,bP,P>::npsv_width
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  avl_array<T,A,bW,W,bP,P,B>::npsv_width
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   AA_ASSERT (bW);           // No NPSV
   AA_ASSERT (p);            // NULL pointer dereference
 
-  return bW ? *p->m_node_width : *(W*)NULL;
+  return *p->m_node_width;  // (a static dummy without bW)
 }
 
 // iterator_pointer(): return the node pointer of an
@@ -110,11 +110,11 @@ inline //static
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 template<class IT>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::iterator_pointer
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::iterator_pointer
   (const IT & it)
 {
 #ifdef BOOST_CLASS_REQUIRE
@@ -136,11 +136,11 @@ inline //static
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::const_iterator
-  avl_array<T,A,bW,W,bP,P>::make_const_iterator
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  typename avl_array<T,A,bW,W,bP,P,B>::const_iterator
+  avl_array<T,A,bW,W,bP,P,B>::make_const_iterator
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   return const_iterator(p);
 }
@@ -152,11 +152,11 @@ inline //static
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::const_reverse_iterator
-  avl_array<T,A,bW,W,bP,P>::make_const_rev_iter
-  (typename avl_array<T,A,bW,W,bP,P>::node_t * p)
+  typename avl_array<T,A,bW,W,bP,P,B>::const_reverse_iterator
+  avl_array<T,A,bW,W,bP,P,B>::make_const_rev_iter
+  (typename avl_array<T,A,bW,W,bP,P,B>::node_t * p)
 {
   return const_reverse_iterator(p);
 }
@@ -38,10 +38,10 @@ namespace mkr  // Public namespace
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  typename avl_array<T,A,bW,W,bP,P>::node_t *
-  avl_array<T,A,bW,W,bP,P>::dummy () const
+  typename avl_array<T,A,bW,W,bP,P,B>::node_t *
+  avl_array<T,A,bW,W,bP,P,B>::dummy () const
 {
   return static_cast<node_t*> (
          const_cast<my_class*> (this) );
@@ -52,11 +52,11 @@ inline
 //
 // Complexity: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::my_class *
-  avl_array<T,A,bW,W,bP,P>::dummy_owner
-  (const typename avl_array<T,A,bW,W,bP,P>::node_t * pdummy)
+  typename avl_array<T,A,bW,W,bP,P,B>::my_class *
+  avl_array<T,A,bW,W,bP,P,B>::dummy_owner
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t * pdummy)
 {
   AA_ASSERT (!pdummy->m_parent);
 
@@ -70,11 +70,11 @@ inline //static
 //
 // Complexity: O(log N)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline //static
-  typename avl_array<T,A,bW,W,bP,P>::my_class *
-  avl_array<T,A,bW,W,bP,P>::owner
-  (const typename avl_array<T,A,bW,W,bP,P>::node_t * node)
+  typename avl_array<T,A,bW,W,bP,P,B>::my_class *
+  avl_array<T,A,bW,W,bP,P,B>::owner
+  (const typename avl_array<T,A,bW,W,bP,P,B>::node_t * node)
 {
   while (node->m_parent)
     node = node->m_parent;
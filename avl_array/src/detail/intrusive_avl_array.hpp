@@ -0,0 +1,417 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/intrusive_avl_array.hpp
+  ------------------------------
+
+  Class intrusive_avl_array: a sequence of objects that are not
+  owned by the container. The objects derive from avl_array_hook
+  (see detail/intrusive_hook.hpp), which contains the links and
+  counters of a tree node, so inserting and erasing just link
+  and unlink them: nothing is allocated, copied, or destroyed.
+  An object can be in several sequences at the same time, if it
+  has several hooks (with different tags).
+
+  It is built on top of avl_array (as a private base), so it
+  provides the same random access and the same algorithms for
+  relinking nodes (sort, move, reverse...).
+
+  Methods (the rest are avl_array's ones):
+
+  Default con.: empty intrusive_avl_array (O(1))
+  Sequence con.: link the objects in [from,to) (O(n log n))
+  Destructor: unlink all (O(N))
+  swap(): interchange contents (O(1))
+  it insert(it,t): link t before it (O(log N))
+  insert(it,from,to): link [from,to) before it (O(n log N))
+  push_front(t), push_back(t): (O(log N))
+  it erase(it): unlink an object (O(log N))
+  it erase(from,to): unlink a range (O(n log N))
+  pop_front(), pop_back(): (O(log N))
+  clear(): unlink all (O(N))
+  iterator_to(t): get an iterator referring t (O(1))
+*/
+
+#ifndef _AVL_ARRAY_INTRUSIVE_AVL_ARRAY_HPP_
+#define _AVL_ARRAY_INTRUSIVE_AVL_ARRAY_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                       // Intrusive container
+         class Tag=void,                // class (T must derive
+         bool bW=false,                 // from avl_array_hook
+         class W=std::size_t,           // with the same
+         bool bP=false,                 // parameters)
+         class P=std::size_t>
+class intrusive_avl_array
+  : private avl_array<T,intrusive_allocator<T,Tag>,bW,W,bP,P>
+{
+  // -------------------------- TYPES ----------------------------
+
+  public:
+
+    typedef avl_array<T,intrusive_allocator<T,Tag>,
+                      bW,W,bP,P>                 avl_array_t;
+    typedef avl_array_hook<T,Tag,bW,W,bP,P>      hook_type;
+
+  private:
+
+    typedef avl_array_node_tree_fields<T,
+                      intrusive_allocator<T,Tag>,
+                      bW,W,bP,P,avl_balance>     node_t;
+    typedef intrusive_avl_array<T,Tag,bW,W,bP,P> my_class;
+
+  public:
+
+    typedef typename avl_array_t::value_type      value_type;
+    typedef typename avl_array_t::reference       reference;
+    typedef typename avl_array_t::const_reference const_reference;
+    typedef typename avl_array_t::pointer         pointer;
+    typedef typename avl_array_t::const_pointer   const_pointer;
+    typedef typename avl_array_t::size_type       size_type;
+    typedef typename avl_array_t::difference_type difference_type;
+
+    typedef typename avl_array_t::iterator        iterator;
+    typedef typename avl_array_t::const_iterator  const_iterator;
+    typedef typename avl_array_t::reverse_iterator
+                                                  reverse_iterator;
+    typedef typename avl_array_t::const_reverse_iterator
+                                            const_reverse_iterator;
+
+
+  // ---------------------- PUBLIC INTERFACE ---------------------
+
+  public:
+
+    // Constructors and destructor
+    //
+    // Default con.: empty intrusive_avl_array (O(1))
+    // Sequence con.: link the objects in [from,to) (O(n log n))
+    // Destructor: unlink all; don't destroy them (O(N))
+
+    intrusive_avl_array ();
+
+    template <class IT>
+    intrusive_avl_array (IT from, IT to);
+
+    ~intrusive_avl_array ();
+
+
+    // Container swap
+    //
+    // swap(): interchange contents (O(1))
+
+    void swap (my_class & a);
+
+
+    // Linking and unlinking
+    //
+    // it insert(it,t): link t before it (O(log N))
+    // insert(it,from,to): link [from,to) before it (O(n log N))
+    // push_front(t): link t before the first (O(log N))
+    // push_back(t): link t after the last (O(log N))
+    // it erase(it): unlink an object (O(log N))
+    // it erase(from,to): unlink a range (O(n log N))
+    // pop_front(): unlink the first (O(log N))
+    // pop_back(): unlink the last (O(log N))
+    // clear(): unlink all (O(N))
+    // iterator_to(t): iterator referring t (O(1))
+
+    iterator insert (iterator it, reference t);
+
+    template <class IT>
+    void insert (iterator it, IT from, IT to);
+
+    void push_front (reference t);
+    void push_back (reference t);
+
+    iterator erase (iterator it);
+    iterator erase (iterator from, iterator to);
+
+    void pop_front ();
+    void pop_back ();
+
+    void clear ();
+
+    static iterator iterator_to (reference t);
+    static const_iterator iterator_to (const_reference t);
+
+
+    // Methods of avl_array that don't create or destroy nodes
+
+    using avl_array_t::size;
+    using avl_array_t::empty;
+    using avl_array_t::max_size;
+
+    using avl_array_t::begin;
+    using avl_array_t::end;
+    using avl_array_t::rbegin;
+    using avl_array_t::rend;
+
+    using avl_array_t::operator[];
+    using avl_array_t::operator();
+    using avl_array_t::at;
+    using avl_array_t::front;
+    using avl_array_t::back;
+
+    using avl_array_t::swap;           // swap(it,it)
+    using avl_array_t::move;
+    using avl_array_t::reverse;
+
+    using avl_array_t::binary_search;
+    using avl_array_t::sort;
+    using avl_array_t::stable_sort;
+    using avl_array_t::partition;
+    using avl_array_t::stable_partition;
+
+    using avl_array_t::parallel_for_each;
+    using avl_array_t::parallel_reduce;
+
+    using avl_array_t::npsv_update_sums;
+    using avl_array_t::npsv_width;
+    using avl_array_t::npsv_set_width;
+    using avl_array_t::npsv_pos_of;
+    using avl_array_t::npsv_at_pos;
+
+
+  // ------------------ PRIVATE HELPER METHODS -------------------
+
+  private:
+
+    intrusive_avl_array (const my_class &);   // Not copyable:
+    void operator= (const my_class &);        // objects aren't ours
+
+    static node_t * hook_of (reference t);    // Node inside t
+};
+
+//////////////////////////////////////////////////////////////////
+
+// Default constructor: create an empty intrusive_avl_array
+//
+// Complexity: O(1)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::intrusive_avl_array ()
+{
+}
+
+// Sequence constructor: create an intrusive_avl_array with
+// the objects of [from,to) (IT must be an iterator whose
+// operator* returns a T&). If one of them is linked yet,
+// hook_already_linked is thrown, and nothing remains
+// linked.
+//
+// Complexity: O(n log n)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+template<class IT>
+inline
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::intrusive_avl_array
+  (IT from, IT to)
+{
+  try
+  {
+    insert (end (), from, to);
+  }
+  catch (...)
+  {
+    avl_array_t::unlink_all ();  // The avl_array destructor
+    throw;                       // would destroy them
+  }
+}
+
+// Destructor: unlink all the objects (but don't destroy
+// them; they belong to the user)
+//
+// Complexity: O(N)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::~intrusive_avl_array ()
+{
+  avl_array_t::unlink_all ();
+}
+
+// swap(): interchange the contents of two containers,
+// just relinking their roots
+//
+// Complexity: O(1)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::swap
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::my_class & a)
+{
+  avl_array_t::swap (a);
+}
+
+// insert(): link the object t, which must not be linked
+// in any other intrusive_avl_array with the same tag, before
+// the position it. Return an iterator referring t. If t is
+// linked yet, throw hook_already_linked.
+//
+// Complexity: O(log N)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::insert
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator it,
+   typename intrusive_avl_array<T,Tag,bW,W,bP,P>::reference t)
+{
+  return avl_array_t::link_node (hook_of (t), it);
+}
+
+// insert(): link the objects of [from,to), in order, before
+// the position it. If one of them is linked yet, throw
+// hook_already_linked (the previous ones remain linked).
+//
+// Complexity: O(n log N)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+template<class IT>
+//not inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::insert
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator it,
+   IT from, IT to)
+{
+  for (; from!=to; ++from)
+    avl_array_t::link_node (hook_of (*from), it);
+}
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::push_front
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::reference t)
+{
+  avl_array_t::link_node (hook_of (t), begin ());
+}
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::push_back
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::reference t)
+{
+  avl_array_t::link_node (hook_of (t), end ());
+}
+
+// erase(): unlink the object referred by it (it is not
+// destroyed, and it can be linked again later). Return an
+// iterator referring the next element.
+//
+// Complexity: O(log N)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::erase
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator it)
+{
+  return avl_array_t::unlink_node (it);
+}
+
+// erase(): unlink the objects of [from,to). Return to.
+//
+// Complexity: O(n log N)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+//not inline
+  typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::erase
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator from,
+   typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator to)
+{
+  while (from!=to)
+    from = avl_array_t::unlink_node (from);
+
+  return to;
+}
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::pop_front ()
+{
+  avl_array_t::unlink_node (begin ());
+}
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::pop_back ()
+{
+  avl_array_t::unlink_node (-- end ());
+}
+
+// clear(): unlink all the objects (they are not destroyed)
+//
+// Complexity: O(N)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline
+  void
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::clear ()
+{
+  avl_array_t::unlink_all ();
+}
+
+// iterator_to(): return an iterator referring the object
+// t, which must be linked in some intrusive_avl_array with
+// this tag. Its index is then iterator_to(t)-begin().
+//
+// Complexity: O(1)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline //static
+  typename intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator_to
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::reference t)
+{
+  return avl_array_t::iterator_of (hook_of (t));
+}
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline //static
+  typename intrusive_avl_array<T,Tag,bW,W,bP,P>::const_iterator
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::iterator_to
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::const_reference t)
+{
+  return avl_array_t::iterator_of (hook_of (const_cast<T&>(t)));
+}
+
+// hook_of(): get the tree node inside the object t
+//
+// Complexity: O(1)
+
+template<class T,class Tag,bool bW,class W,bool bP,class P>
+inline //static
+  typename intrusive_avl_array<T,Tag,bW,W,bP,P>::node_t *
+  intrusive_avl_array<T,Tag,bW,W,bP,P>::hook_of
+  (typename intrusive_avl_array<T,Tag,bW,W,bP,P>::reference t)
+{
+  return &static_cast<hook_type&>(t);
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
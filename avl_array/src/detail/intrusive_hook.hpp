@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/intrusive_hook.hpp
+  -------------------------
+
+  Support for intrusive_avl_array, whose nodes are the user's
+  objects themselves. The user type derives from avl_array_hook
+  (once per sequence it must be in, with a different tag every
+  time), which contains the tree fields of a node. The container
+  is an avl_array whose "allocator" is intrusive_allocator: it
+  never allocates anything, and it selects a node type whose
+  payload is the object that contains the hook.
+
+  Available classes are:
+
+    class avl_array_hook        (public: base class of user types)
+    class intrusive_allocator   (pseudo-allocator, never used)
+    class avl_array_node        (specialization: payload is the
+                                 object containing the hook)
+*/
+
+#ifndef _AVL_ARRAY_INTRUSIVE_HOOK_HPP_
+#define _AVL_ARRAY_INTRUSIVE_HOOK_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+template<class T, class Tag>  // Allocator of intrusive containers:
+class intrusive_allocator     // the nodes are the user's objects,
+{                             // so nothing is ever allocated
+  public:
+
+    typedef T                   value_type;
+    typedef T *                 pointer;
+    typedef const T *           const_pointer;
+    typedef T &                 reference;
+    typedef const T &           const_reference;
+    typedef std::size_t         size_type;
+    typedef std::ptrdiff_t      difference_type;
+
+    template<class U> struct rebind
+    {
+      typedef intrusive_allocator<U,Tag> other;
+    };
+
+    intrusive_allocator () { }
+
+    template<class U>
+    intrusive_allocator (const intrusive_allocator<U,Tag> &) { }
+
+    pointer allocate (size_type, const void * =NULL)
+    {
+      AA_ASSERT (false);    // Never called (if it was, new_node()
+      return NULL;          // would throw allocator_returned_null)
+    }
+
+    void deallocate (pointer, size_type) { }
+
+    size_type max_size () const { return size_type(-1)/sizeof(T); }
+
+    template<class U>
+    bool operator== (const intrusive_allocator<U,Tag> &) const
+    {
+      return true;          // Objects can go from one container
+    }                       // to another with the same tag
+
+    template<class U>
+    bool operator!= (const intrusive_allocator<U,Tag> &) const
+    {
+      return false;
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                    // Hook for putting objects
+         class Tag=void,             // of type T (derived from
+         bool bW=false,              // it) in an
+         class W=std::size_t,        // intrusive_avl_array with
+         bool bP=false,              // the same parameters
+         class P=std::size_t>
+class avl_array_hook
+  : public detail::avl_array_node_tree_fields
+             <T,detail::intrusive_allocator<T,Tag>,bW,W,bP,P,
+              avl_balance>
+{
+  typedef detail::avl_array_node_tree_fields
+            <T,detail::intrusive_allocator<T,Tag>,
+             bW,W,bP,P,avl_balance>                node_t;
+
+  public:
+
+    avl_array_hook () { }
+
+    avl_array_hook (const avl_array_hook &)   // Copies of an
+      : node_t() { }                          // object are not
+                                              // linked anywhere
+    avl_array_hook & operator= (const avl_array_hook &)
+    {
+      return *this;                           // Links stay
+    }
+
+    ~avl_array_hook ()
+    {
+      AA_ASSERT (!is_linked ());  // Unlink before destruction!
+    }
+
+    bool is_linked () const       // Is it in a sequence now?
+    {
+      return node_t::m_parent!=NULL;
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+template<class T, class Tag,
+         bool bW, class W,       // Intrusive node: it is never
+         bool bP, class P,       // built, it just tells avl_array
+         class B>                // where the payload is
+class avl_array_node<T,
+                     intrusive_allocator<T,Tag>,
+                     bW,W,bP,P,B>
+  : private avl_array_node_tree_fields<T,
+                                       intrusive_allocator<T,Tag>,
+                                       bW,W,bP,P,B>
+{
+  friend class mkr::avl_array<T,intrusive_allocator<T,Tag>,
+                              bW,W,bP,P,B>;
+
+  typedef avl_array_node_tree_fields<T,
+                                     intrusive_allocator<T,Tag>,
+                                     bW,W,bP,P,B>   node_t;
+  typedef avl_array_hook<T,Tag,bW,W,bP,P>           hook_t;
+
+  private:  // Only avl_array<T,A,W,P> has access to this class
+
+    avl_array_node ();                        // Never built
+
+    static T & payload (node_t * p)           // The payload
+    {                                         // is the object
+      return static_cast<T&>                  // whose hook is p
+               (static_cast<hook_t&>(*p));
+    }
+};
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,406 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/iterator_algo.hpp
+  ------------------------
+
+  Overloads of some standard iterator functions and algorithms
+  for avl_array iterators (straight and reverse). Unless
+  AA_USE_RANDOM_ACCESS_TAG is defined, the iterators are tagged
+  as bidirectional, so the std:: versions of these step one by
+  one. The overloads below use the tree instead (jump() and
+  position_of_node()). They live in the namespace of the
+  iterators, so they are found by argument dependent lookup
+  when called without qualification (like swap):
+
+    using std::distance;
+    n = distance (a.begin(), it);   // O(log N), not O(N)
+
+  Available functions are:
+
+    distance(first,last)                  (O(log N))
+    advance(it,n)                         (O(log N))
+    next(it[,n]), prev(it[,n])            (O(log N))
+    lower_bound(first,last,t[,cmp])       (O(log^2 N))
+    upper_bound(first,last,t[,cmp])       (O(log^2 N))
+    equal_range(first,last,t[,cmp])       (O(log^2 N))
+    partition_point(first,last,pred)      (O(log^2 N))
+
+  And, for private use only:
+
+    class less_than          (default comparison: a<b)
+    class lesser_than_value  (predicate: element < value)
+    class not_greater_value  (predicate: !(value < element))
+    bisect()                 (common binary search)
+*/
+
+#ifndef _AVL_ARRAY_ITERATOR_ALGO_HPP_
+#define _AVL_ARRAY_ITERATOR_ALGO_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER CLASSES --------------------
+
+class less_than                 // Default comparison: operator<
+{                               // (of possibly different types,
+  public:                       // like the std:: algorithms)
+
+    template<class X, class Y>
+    bool operator() (const X & x, const Y & y) const
+    { return x < y; }
+};
+
+template<class V, class CMP>    // Predicate of lower_bound():
+class lesser_than_value         // true while the element is
+{                               // lesser than the value
+  public:
+
+    lesser_than_value (const V & v, CMP cmp)
+      : m_v(v), m_cmp(cmp) {}
+
+    template<class X>
+    bool operator() (const X & x) const
+    { return m_cmp (x, m_v); }
+
+  private:
+
+    const V & m_v;
+    CMP m_cmp;
+};
+
+template<class V, class CMP>    // Predicate of upper_bound():
+class not_greater_value         // true while the element is not
+{                               // greater than the value
+  public:
+
+    not_greater_value (const V & v, CMP cmp)
+      : m_v(v), m_cmp(cmp) {}
+
+    template<class X>
+    bool operator() (const X & x) const
+    { return !m_cmp (m_v, x); }
+
+  private:
+
+    const V & m_v;
+    CMP m_cmp;
+};
+
+// bisect(): find the first element in [first,last) for which
+// pred is false, assuming that it is true for all elements
+// before it and false for all after it. The classic binary
+// search, but every step is an O(log N) jump instead of
+// an O(N) walk.
+//
+// Complexity: O(log^2 N)
+
+template<class IT, class PRED>
+//not inline
+  IT bisect (IT first, IT last, PRED pred)
+{
+  typename IT::difference_type n, half;
+  IT mid;
+
+  n = last - first;          // O(log N)
+
+  while (n>0)
+  {
+    half = n >> 1;
+    mid = first + half;      // O(log N)
+
+    if (pred (*mid))         // Still true: go right
+    {
+      first = ++ mid;
+      n -= half + 1;
+    }
+    else                     // False: go left (mid might
+      n = half;              // be the one)
+  }
+
+  return first;
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// distance(), advance(), next() and prev(): O(log N) versions
+// of the std:: ones, for straight and reverse iterators
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr>
+inline
+  typename avl_array_iterator<T,A,bW,W,bP,P,B,
+                                     Ref,Ptr>::difference_type
+  distance (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+            avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last)
+{
+  return last - first;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr>
+inline
+  typename avl_array_rev_iter<T,A,bW,W,bP,P,B,
+                                     Ref,Ptr>::difference_type
+  distance (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+            avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last)
+{
+  return last - first;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class D>
+inline
+  void
+  advance (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> & it, D n)
+{
+  it += typename avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>::
+                                              difference_type(n);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class D>
+inline
+  void
+  advance (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> & it, D n)
+{
+  it += typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
+                                              difference_type(n);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  next (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> it,
+        typename avl_array_iterator<T,A,bW,W,bP,P,B,
+                                      Ref,Ptr>::difference_type n=1)
+{
+  return it += n;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  next (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> it,
+        typename avl_array_rev_iter<T,A,bW,W,bP,P,B,
+                                      Ref,Ptr>::difference_type n=1)
+{
+  return it += n;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  prev (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> it,
+        typename avl_array_iterator<T,A,bW,W,bP,P,B,
+                                      Ref,Ptr>::difference_type n=1)
+{
+  return it -= n;
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  prev (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> it,
+        typename avl_array_rev_iter<T,A,bW,W,bP,P,B,
+                                      Ref,Ptr>::difference_type n=1)
+{
+  return it -= n;
+}
+
+// lower_bound(), upper_bound(), equal_range() and
+// partition_point(): O(log^2 N) versions of the std:: ones,
+// for straight and reverse iterators. Like them, they only
+// require the range to be partitioned (in order, for the
+// first three). Note that, when the whole array is searched,
+// avl_array::binary_search() is faster still (O(log N)).
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class PRED>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  partition_point (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+                   avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+                   PRED pred)
+{
+  return bisect (first, last, pred);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class PRED>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  partition_point (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+                   avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+                   PRED pred)
+{
+  return bisect (first, last, pred);
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V,class CMP>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  lower_bound (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t, CMP cmp)
+{
+  return bisect (first, last, lesser_than_value<V,CMP>(t, cmp));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V,class CMP>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  lower_bound (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t, CMP cmp)
+{
+  return bisect (first, last, lesser_than_value<V,CMP>(t, cmp));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  lower_bound (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t)
+{
+  return lower_bound (first, last, t, less_than());
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  lower_bound (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t)
+{
+  return lower_bound (first, last, t, less_than());
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V,class CMP>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  upper_bound (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t, CMP cmp)
+{
+  return bisect (first, last, not_greater_value<V,CMP>(t, cmp));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V,class CMP>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  upper_bound (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t, CMP cmp)
+{
+  return bisect (first, last, not_greater_value<V,CMP>(t, cmp));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V>
+inline
+  avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>
+  upper_bound (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t)
+{
+  return upper_bound (first, last, t, less_than());
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V>
+inline
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  upper_bound (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t)
+{
+  return upper_bound (first, last, t, less_than());
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V,class CMP>
+inline
+  std::pair<avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>,
+            avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> >
+  equal_range (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t, CMP cmp)
+{
+  first = lower_bound (first, last, t, cmp);    // Search the end
+                                                // from the start
+  return std::make_pair (first, upper_bound (first, last, t, cmp));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V,class CMP>
+inline
+  std::pair<avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>,
+            avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> >
+  equal_range (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t, CMP cmp)
+{
+  first = lower_bound (first, last, t, cmp);
+  return std::make_pair (first, upper_bound (first, last, t, cmp));
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V>
+inline
+  std::pair<avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>,
+            avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> >
+  equal_range (avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t)
+{
+  return equal_range (first, last, t, less_than());
+}
+
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
+         class Ref,class Ptr,class V>
+inline
+  std::pair<avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>,
+            avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> >
+  equal_range (avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> first,
+               avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> last,
+               const V & t)
+{
+  return equal_range (first, last, t, less_than());
+}
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+}  // namespace mkr
+
+#endif
@@ -33,16 +33,16 @@ namespace mkr  // Public namespace
 
 template<class T, class A,
          bool bW, class W,
-         bool bP, class P,             // 2-in-1 trick: Ref and
+         bool bP, class P, class B,    // 2-in-1 trick: Ref and
          class Ref, class Ptr>         // Ptr are re-defined for
 class avl_array_rev_iter               // const_iterator
 {
-  friend class mkr::avl_array<T,A,bW,W,bP,P>;
+  friend class mkr::avl_array<T,A,bW,W,bP,P,B>;
 
-  typedef avl_array_node_tree_fields<T,A,bW,W,bP,P>    node_t;
-  typedef avl_array_iterator<T,A,bW,W,bP,P,Ref,Ptr>    my_reverse;
-  typedef avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>    my_class;
-  typedef mkr::avl_array<T,A,bW,W,bP,P>                my_array;
+  typedef avl_array_node_tree_fields<T,A,bW,W,bP,P,B>  node_t;
+  typedef avl_array_iterator<T,A,bW,W,bP,P,B,Ref,Ptr>  my_reverse;
+  typedef avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>  my_class;
+  typedef mkr::avl_array<T,A,bW,W,bP,P,B>              my_array;
 
   public: // -------------- PUBLIC INTERFACE ----------------
 
@@ -101,29 +101,29 @@ class avl_array_rev_iter               // const_iterator
     // Iterators difference: O(log N)
 
     template<class X,class Y> difference_type operator-
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
     // Equality comparisons: O(1)
 
     template<class X,class Y> bool operator==
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
     template<class X,class Y> bool operator!=
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
     // Lesser/greater comparisons: O(log N)
 
     template<class X,class Y> bool operator<
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
     template<class X,class Y> bool operator>
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
     template<class X,class Y> bool operator<=
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
     template<class X,class Y> bool operator>=
-      (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it) const;
+      (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it) const;
 
   private: // ----- PRIVATE DATA MEMBER AND HELPER FUN. ------
 
@@ -144,16 +144,16 @@ class avl_array_rev_iter               // const_iterator
 
 // Default constructor: create a singular iterator
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
   avl_array_rev_iter () : ptr(NULL) {}
 
 // Copy constructor: just copy the embedded pointer
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
   avl_array_rev_iter (const my_class & it) { ptr = it.ptr; }
 
 // Conversion from reverse iterator: copy the pointer (yes, the
@@ -161,71 +161,71 @@ inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
 // not to its neighbor). The helper method it_ptr() calls a
 // method of the avl_array class, which has access to the pointer
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
   avl_array_rev_iter (const my_reverse & it) { ptr = it_ptr(it); }
 
 // Conversion to const iterator. Again through the avl_array class
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
-  operator typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
+  operator typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
   const_iterator () const
 { return my_array::make_const_rev_iter(ptr); } // (reverse...)
 
 // Dereference. data() asserts that this is neither a singular
 // iterator nor an end node.
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+inline typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                                           reference
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                                  operator* () const
 { return my_array::data (ptr); }
 
 // The arrow can be used when T is a struct or class
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::pointer
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator->() const
+inline typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::pointer
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator->() const
 { return &**this; }
 
 // Index operator [] indirectly calls avl_array::jump(), which
 // takes O(log N) time. NOTE: avl_array::jump() does check the
 // range
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+inline typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                                           reference
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator[]
-  (typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator[]
+  (typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                            difference_type n) const
 { return *(*this+n); }
 
 // Index operator () does exactly the same as operator []
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 inline
-  typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+  typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                                     const_reference
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator()
-  (typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator()
+  (typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                            difference_type n) const
 { return *(*this+n); }
 
 // Access to Non-Proportional Sequence View (NPSV)
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 inline
   const W &
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::npsv_width () const
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::npsv_width () const
 { return my_array::npsv_width (ptr); }
 
 // Operators ++ and -- iterate through the list. They require a
@@ -233,38 +233,38 @@ inline
 // They need to call helper methods of avl_array because the
 // iterator class is not friend of the node class
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> &       // (pre++)
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator++ ()
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> &     // (pre++)
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator++ ()
 {
   ptr = my_array::prev (ptr);    // Step back! (reverse...)
   return *this;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> &       // (pre--)
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator-- ()
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> &     // (pre--)
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator-- ()
 {
   ptr = my_array::next (ptr);    // Step forward! (reverse...)
   return *this;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>        // (post++)
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator++ (int)
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>      // (post++)
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator++ (int)
 {
   my_class tmp(*this);
   ptr = my_array::prev (ptr);    // Step back! (reverse...)
   return tmp;                    // Return unmodified copy
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>        // (post--)
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator-- (int)
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>      // (post--)
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator-- (int)
 {
   my_class tmp(*this);
   ptr = my_array::next (ptr);    // Step forward! (reverse...)
@@ -276,10 +276,10 @@ inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>        // (post--)
 // which takes between O(log n) and O(log N) time (n is the size
 // of the jump, and N is the size of the avl_array)
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator+
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator+
   (difference_type n)                             const
 {
   my_class tmp(*this);
@@ -288,34 +288,34 @@ inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>
   return tmp;
 }                           // jump() takes logarithmic time
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> operator+
-  (typename avl_array<T,A,bW,W,bP,P>::difference_type n,
-   const avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> & it)
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> operator+
+  (typename avl_array<T,A,bW,W,bP,P,B>::difference_type n,
+   const avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> & it)
 { return it + n; }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator-
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator-
   (difference_type n)                             const
 { return *this + -n; }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> &
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator+=
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> &
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator+=
   (difference_type n)
 {
   *this = *this + n;
   return *this;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
-inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> &
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator-=
+inline avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr> &
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator-=
   (difference_type n)
 { return *this += -n; }
 
@@ -323,22 +323,22 @@ inline avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr> &
 // O(log N) time. It checks the consistency of operands regarding
 // the container they refer (should be the same for both)
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline
-  typename avl_array_rev_iter<T,A,bW,W,bP,P,
+  typename avl_array_rev_iter<T,A,bW,W,bP,P,B,
                                      Ref,Ptr>::difference_type
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator-
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)    const
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator-
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)  const
 {
   my_array * a, * b;
   size_type m, n;
 
   if (!ptr && !it_ptr(it)) return 0;  // Both singular
 
-  m = my_array::position_of_node (ptr, a, false);
-  n = my_array::position_of_node (it_ptr(it), b, false);
+  m = my_array::position_of_node (ptr, a, true);
+  n = my_array::position_of_node (it_ptr(it), b, true);
 
   AA_ASSERT (a==b); // Inter-array distance has no sense
 
@@ -349,99 +349,105 @@ inline
 // Equality and inequality operators take O(1) time. They can
 // also mix const and var iterators
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline bool
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator==
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)     const
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator==
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)   const
 { return ptr==it_ptr(it); }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline bool
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator!=
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)     const
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator!=
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)   const
 { return ptr!=it_ptr(it); }
 
 // Greater and lesser operators take O(log N) time in general.
 // They will take just O(1) in the cases where the result can
-// be decided with a simple equality/inequality comparison.
-// The compared iterators must refer the same container
+// be decided with a simple equality/inequality comparison,
+// and always with order labels (bP=true, see
+// detail/aa_order.hpp). The compared iterators must refer
+// the same container
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline bool
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator<
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)     const
-{ return ptr==it_ptr(it) ? false : *this-it<0; }
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator<
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)   const
+{ return ptr==it_ptr(it) ? false :
+         my_array::node_precedes (ptr, it_ptr(it), true); }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline bool
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator>
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)     const
-{ return ptr==it_ptr(it) ? false : *this-it>0; }
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator>
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)   const
+{ return ptr==it_ptr(it) ? false :
+         my_array::node_precedes (it_ptr(it), ptr, true); }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline bool
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator<=
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)     const
-{ return ptr==it_ptr(it) ? true : *this-it<0; }
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator<=
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)   const
+{ return ptr==it_ptr(it) ? true :
+         !my_array::node_precedes (it_ptr(it), ptr, true); }
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 template<class X,  class Y>
 inline bool
-  avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::operator>=
-  (const avl_array_rev_iter<T,A,bW,W,bP,P,X,Y> & it)     const
-{ return ptr==it_ptr(it) ? true : *this-it>0; }
+  avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::operator>=
+  (const avl_array_rev_iter<T,A,bW,W,bP,P,B,X,Y> & it)   const
+{ return ptr==it_ptr(it) ? true :
+         !my_array::node_precedes (ptr, it_ptr(it), true); }
 
 //////////////////////////////////////////////////////////////////
 
 // Iterator tag function iterator_category()
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 inline
-  typename avl_array_rev_iter<T,A,bW,W,bP,P,
+  typename avl_array_rev_iter<T,A,bW,W,bP,P,B,
                                      Ref,Ptr>::iterator_category
-  iterator_category (const avl_array_rev_iter<T,A,bW,W,bP,P,
+  iterator_category (const avl_array_rev_iter<T,A,bW,W,bP,P,B,
                                                      Ref,Ptr>&)
 {
-  return typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+  return typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                           iterator_category();
 }
 
 // Iterator tag function value_type()
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 inline
-  typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::value_type *
-  value_type (const avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>&)
+  typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::value_type *
+  value_type (const avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>&)
 {
   return reinterpret_cast<
-          typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+          typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                                   value_type *>(0);
 }
 
 // Iterator tag function distance_type()
 
-template<class T,class A,bool bW,class W,bool bP,class P,
+template<class T,class A,bool bW,class W,bool bP,class P,class B,
          class Ref,class Ptr>
 inline
-  typename avl_array_rev_iter<T,A,bW,W,bP,P,
+  typename avl_array_rev_iter<T,A,bW,W,bP,P,B,
                                      Ref,Ptr>::difference_type *
-  distance_type (const avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>&)
+  distance_type (const avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>&)
 {
   return reinterpret_cast<
-          typename avl_array_rev_iter<T,A,bW,W,bP,P,Ref,Ptr>::
+          typename avl_array_rev_iter<T,A,bW,W,bP,P,B,Ref,Ptr>::
                                         difference_type *>(0);
 }
 
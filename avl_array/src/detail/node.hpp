@@ -14,6 +14,13 @@
   the links required by tree nodes. It does _not_ contain the
   payload value_type (see detail/node_with_data.hpp).
 
+  The optional fields (order label and NPSV widths) live in its
+  base classes avl_array_node_label and avl_array_node_width.
+  When a feature is disabled (bP or bW false), the base class is
+  empty: its field becomes a static dummy that costs no memory
+  per node, and that is only touched by code under if(bP) or
+  if(bW), which the compiler removes.
+
   Two classes inherit from avl_array_node_tree_fields:
 
     avl_array_node   (see detail/node_with_data.hpp)
@@ -27,10 +34,6 @@
 #error "Don't include this file. Include avl_array.hpp instead."
 #endif
 
-#if !defined(__GNUC__) || defined(__MINGW32__)
-#define AA_NO_ZERO_SIZE_ARRAYS
-#endif
-
 namespace mkr  // Public namespace
 {
 
@@ -49,18 +52,72 @@ namespace mkr  // Public namespace
 
 typedef enum { L=0, R=1 } enum_left_right;
 
+//////////////////////////////////////////////////////////////////
+/*
+  Optional fields. The enabled versions hold one-element arrays,
+  so that all of them are used in the same way (*m_oldpos...)
+  whether they are enabled or not.
+*/
+
+template<bool bP, class P>        // Order label (see aa_order.hpp)
+class avl_array_node_label
+{
+  protected:
+
+    P m_oldpos[1];          // Order label
+};
+
+template<class P>                 // Disabled: no field at all,
+class avl_array_node_label<false,P> // just a static dummy
+{
+  protected:
+
+    static P m_oldpos[1];   // (never used, see if(bP) checks)
+};
+
+template<class P>
+P avl_array_node_label<false,P>::m_oldpos[1];
+
+template<bool bW, class W,        // Non-Proportional Sequence
+         class Base>              // View (NPSV)
+class avl_array_node_width : public Base
+{
+  protected:
+
+    W m_node_width[1];      // Width of this node
+    W m_total_width[1];     // Width of this subtree (if there
+};                          // are no children, m_node_width
+                            // is used instead)
+template<class W, class Base>     // Disabled: no fields at all,
+class avl_array_node_width<false,W,Base> // just static dummies
+  : public Base
+{
+  protected:
+
+    static W m_node_width[1];   // (never used, see if(bW)
+    static W m_total_width[1];  // checks)
+};
+
+template<class W, class Base>
+W avl_array_node_width<false,W,Base>::m_node_width[1];
+
+template<class W, class Base>
+W avl_array_node_width<false,W,Base>::m_total_width[1];
+
 //////////////////////////////////////////////////////////////////
 
 template<class T, class A,        // Data of a tree node (payload
          bool bW, class W,        // not included)
-         bool bP, class P>
+         bool bP, class P,
+         class B>
 class avl_array_node_tree_fields
+  : public avl_array_node_width<bW,W,avl_array_node_label<bP,P> >
 {                                 // Note that the dummy has no T
 
-  friend class mkr::avl_array<T,A,bW,W,bP,P>;
-  friend class rollback_list<T,A,bW,W,bP,P>;
+  friend class mkr::avl_array<T,A,bW,W,bP,P,B>;
+  friend class rollback_list<T,A,bW,W,bP,P,B>;
 
-  typedef avl_array_node_tree_fields<T,A,bW,W,bP,P>    node_t;
+  typedef avl_array_node_tree_fields<T,A,bW,W,bP,P,B>  node_t;
 
   protected:
 
@@ -74,27 +131,19 @@ class avl_array_node_tree_fields
     node_t * m_next;        // (last_node.next==dummy)
     node_t * m_prev;        // (first_node.prev==dummy)
 
-    // Data for balancing, indexing, and stable-sort
+    // Data for balancing, indexing, and ordering/stable-sort
 
     std::size_t m_height;   // Levels in subtree, including self
     std::size_t m_count;    // Nodes in subtree, including self
 
-#ifndef AA_NO_ZERO_SIZE_ARRAYS
-    P m_oldpos[bP?1:0];     // Position (used only in stable_sort)
-#else
-    P m_oldpos[1];          // (zero size arrays are not standard)
-#endif
+    // Order label and NPSV widths: inherited (see above)
 
-    // Non-Proportional Sequence View (NPSV)
+    typedef avl_array_node_label<bP,P>                 label_t;
+    typedef avl_array_node_width<bW,W,label_t>         width_t;
 
-#ifndef AA_NO_ZERO_SIZE_ARRAYS
-    W m_node_width[bW?1:0];   // Width of this node
-    W m_total_width[bW?1:0];  // Width of this subtree (if there
-                              // are no children, m_node_width is
-#else                         // used instead)
-    W m_node_width[1];
-    W m_total_width[1];     // (zero size arrays are not standard)
-#endif
+    using label_t::m_oldpos;
+    using width_t::m_node_width;
+    using width_t::m_total_width;
 
     // Constructor and initializer, both O(1)
 
@@ -122,9 +171,9 @@ class avl_array_node_tree_fields
 
 // Initializer, or "reset" method: write default values
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   init_tree_fields ()                    // Write default values
 {
   m_parent =
@@ -136,9 +185,9 @@ inline void
 
 // Initializer, or "reset" method: write default values
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   init ()                                // Write default values
 {                                        // Init NPSV width too
   init_tree_fields ();
@@ -149,56 +198,67 @@ inline void
 
 // Constructor: just call init()
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   avl_array_node_tree_fields ()
-{ init (); }
+{
+#ifdef AA_CXX11
+  static_assert (sizeof (node_t) <                 // Disabled
+                 sizeof (node_t*) * (5+1) +        // fields must
+                 sizeof (std::size_t) * 2 +        // cost nothing
+                 (bP ? sizeof (P) : 0) +           // (5 links, and
+                 (bW ? sizeof (W) * 2 : 0),        // less than a
+                 "unexpected size of avl_array node"); // pointer of
+#endif                                             // padding)
+
+  init ();
+}
 
 // Helper functions: return count/height/width of left/right
 // subtree. This doesn't require loops or recursion. If the
 // left/right subtree is empty, return 0; otherwise, return
 // the count/height/width of its root. Time required is O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline std::size_t
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   left_count ()                               const
 {
   return m_children[L] ?
          m_children[L]->m_count : 0;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline std::size_t
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   right_count ()                              const
 {
   return m_children[R] ?
          m_children[R]->m_count : 0;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline std::size_t
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   left_height ()                              const
 {
   return m_children[L] ?
          m_children[L]->m_height : 0;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline std::size_t
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   right_height ()                             const
 {
   return m_children[R] ?
          m_children[R]->m_height : 0;
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   get_left_width (W & w)                      const
 {
   AA_ASSERT (bW);
@@ -207,9 +267,9 @@ inline void
       m_children[L]->total_width() : W(0);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   get_right_width (W & w)                     const
 {
   AA_ASSERT (bW);
@@ -218,9 +278,9 @@ inline void
       m_children[R]->total_width() : W(0);
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   update_width ()
 {
   if (!bW)
@@ -241,18 +301,15 @@ inline void
   }
 }
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline const W &
-  avl_array_node_tree_fields<T,A,bW,W,bP,P>::
+  avl_array_node_tree_fields<T,A,bW,W,bP,P,B>::
   total_width ()                        const
 {
   AA_ASSERT (bW);
 
-  if (bW)
-    return (m_children[L] || m_children[R]) ? *m_total_width :
-                                              *m_node_width;
-  else
-    return *(W*)NULL;
+  return (m_children[L] || m_children[R]) ? *m_total_width :
+                                            *m_node_width;
 }
 
 //////////////////////////////////////////////////////////////////
@@ -261,9 +318,5 @@ inline const W &
 
 }  // namespace mkr
 
-#ifdef AA_NO_ZERO_SIZE_ARRAYS
-#undef AA_NO_ZERO_SIZE_ARRAYS
-#endif
-
 #endif
 
@@ -16,7 +16,9 @@
   "copy" constructor is provided for copying from value_type.
   Therefore, construction from scratch and normal copy
   construction need to be defined too (they work just like the
-  default constructors would).
+  default constructors would). The payload of a node is reached
+  through payload(), so that intrusive nodes (see
+  detail/intrusive_hook.hpp) can provide it in a different way.
 */
 
 #ifndef _AVL_ARRAY_NODE_WITH_DATA_HPP_
@@ -36,21 +38,22 @@ namespace mkr  // Public namespace
 
 template<class T, class A,
          bool bW, class W,
-         bool bP, class P>       // Tree node (with payload T)
+         bool bP, class P,       // Tree node (with payload T)
+         class B>
 class avl_array_node
-  : private avl_array_node_tree_fields<T,A,bW,W,bP,P>
+  : private avl_array_node_tree_fields<T,A,bW,W,bP,P,B>
 {
-  friend class mkr::avl_array<T,A,bW,W,bP,P>;
+  friend class mkr::avl_array<T,A,bW,W,bP,P,B>;
 
   typedef avl_array_node_tree_fields<T,A,
-                                     bW,W,bP,P>     node_t;
-  typedef avl_array_node<T,A,bW,W,bP,P>             payload_node_t;
+                                     bW,W,bP,P,B>   node_t;
+  typedef avl_array_node<T,A,bW,W,bP,P,B>           payload_node_t;
 
   typedef typename
-          avl_array<T,A,bW,W,bP,P>::value_type      value_type;
+          avl_array<T,A,bW,W,bP,P,B>::value_type    value_type;
   typedef typename
           avl_array<T,A,
-                    bW,W,bP,P>::const_reference     const_reference;
+                    bW,W,bP,P,B>::const_reference   const_reference;
 
   private:  // Only avl_array<T,A,W,P> has access to this class
 
@@ -66,6 +69,12 @@ class avl_array_node
 
     avl_array_node (const_reference t)        // "Copy" ctor.
       : m_data(t) {}                          // (from T)
+
+    static value_type & payload (node_t * p)  // Payload of a
+    {                                         // node (see
+      return static_cast<payload_node_t*>(p)  // avl_array::
+               ->m_data;                      // data())
+    }
 };
 
 //////////////////////////////////////////////////////////////////
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/npsv_interval.hpp
+  ------------------------
+
+  Class npsv_interval: a width type (W) that turns the NPSV of
+  avl_array into an interval tree. Every element gets a closed
+  interval [lo,hi] as its width, and the "sum" of two
+  intervals is the smallest one that covers both. Then the
+  total width of every subtree is the hull of its intervals
+  (minimum lo and maximum hi), maintained by the tree at the
+  same points where the NPSV sums are (counters updates,
+  rotations, joins...), and for_each_overlapping() can skip
+  every subtree whose hull doesn't overlap the query.
+
+  Methods:
+
+  Default / from int con.: empty interval (W(0) and W(1))
+  From bounds con.: interval [lo,hi]
+  empty(), lo(), hi(): (O(1))
+  overlaps(): true if both are non-empty and intersect (O(1))
+  op.+=: hull of both (O(1))
+  op.==, op.<: (O(1))
+*/
+
+#ifndef _AVL_ARRAY_NPSV_INTERVAL_HPP_
+#define _AVL_ARRAY_NPSV_INTERVAL_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+template<class E>                // Closed interval [lo,hi] to be
+class npsv_interval              // used as NPSV width (E needs
+{                                // copy, default con. and op.<)
+  public:
+
+    // Constructors (copy, assignment and destructor are the
+    // default ones). avl_array uses W(0) for "nothing" and
+    // W(1) as the default width of new elements: both are
+    // the empty interval, which never overlaps anything, so
+    // elements must get their intervals with npsv_insert()
+    // or npsv_set_width()
+
+    explicit npsv_interval (int=0)
+      : m_empty(true), m_lo(), m_hi() {}
+
+    npsv_interval (const E & lo, const E & hi)
+      : m_empty(false), m_lo(lo), m_hi(hi) {}
+
+    bool empty () const { return m_empty; }
+    const E & lo () const { return m_lo; }
+    const E & hi () const { return m_hi; }
+
+    bool overlaps (const npsv_interval & other) const
+    {
+      return !m_empty && !other.m_empty &&
+             !(m_hi<other.m_lo) && !(other.m_hi<m_lo);
+    }
+
+    npsv_interval & operator+= (const npsv_interval & other)
+    {
+      if (other.m_empty)            // Hull of both
+        return *this;
+
+      if (m_empty)
+        return *this = other;
+
+      if (other.m_lo<m_lo)
+        m_lo = other.m_lo;
+
+      if (m_hi<other.m_hi)
+        m_hi = other.m_hi;
+
+      return *this;
+    }
+
+    bool operator== (const npsv_interval & other) const
+    {
+      return m_empty ? other.m_empty :
+             !other.m_empty &&
+             !(m_lo<other.m_lo) && !(other.m_lo<m_lo) &&
+             !(m_hi<other.m_hi) && !(other.m_hi<m_hi);
+    }
+
+    bool operator< (const npsv_interval & other) const
+    {                               // (Lexicographic, empty
+      if (other.m_empty)            // first: it has no meaning
+        return false;               // as a position, but it
+                                    // keeps npsv_at_pos() and
+      if (m_empty)                  // the like well defined)
+        return true;
+
+      return m_lo<other.m_lo ||
+             (!(other.m_lo<m_lo) && m_hi<other.m_hi);
+    }
+
+  private:
+
+    bool m_empty;   // If true, m_lo and m_hi are meaningless
+    E m_lo, m_hi;   // Bounds (both included)
+};
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -34,13 +34,14 @@ namespace mkr  // Public namespace
 
 template<class T, class A,
          bool bW, class W,
-         bool bP, class P>            // A list of nodes to
+         bool bP, class P,            // A list of nodes to
+         class B>
 class rollback_list                   // complete or delete
 {
-  friend class mkr::avl_array<T,A,bW,W,bP,P>;
+  friend class mkr::avl_array<T,A,bW,W,bP,P,B>;
 
-  typedef avl_array_node_tree_fields<T,A,bW,W,bP,P> node_t;
-  typedef mkr::avl_array<T,A,bW,W,bP,P> my_array;
+  typedef avl_array_node_tree_fields<T,A,bW,W,bP,P,B> node_t;
+  typedef mkr::avl_array<T,A,bW,W,bP,P,B> my_array;
 
   private:
                           // avl_array that will deallocate
@@ -53,8 +54,8 @@ class rollback_list                   // complete or delete
     rollback_list (my_array * owner); // The one and only constr.
 
                                                // Assignment is a
-    rollback_list<T,A,bW,W,bP,P> & operator=   // no-op (just
-      (const rollback_list<T,A,bW,W,bP,P> &);  // prevents messing
+    rollback_list<T,A,bW,W,bP,P,B> & operator= // no-op (just
+      (const rollback_list<T,A,bW,W,bP,P,B> &);  // prevents messing
                                                // lists)
 
     ~rollback_list ();  // Rollback on destruction (if nodes are
@@ -73,9 +74,9 @@ class rollback_list                   // complete or delete
 // the address of the avl_array. This address will be required for
 // deallocating the nodes in the destructor (in case of rollback)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline rollback_list<T,A,bW,W,
-                         bP,P>::rollback_list (my_array * owner)
+                         bP,P,B>::rollback_list (my_array * owner)
    : m_owner(owner),
      m_first(NULL),
      m_last(NULL)
@@ -86,10 +87,10 @@ inline rollback_list<T,A,bW,W,
 // default assignment that would leave memory leaks and/or
 // provoke double destructions
 
-template<class T,class A,bool bW,class W,bool bP,class P>
-inline rollback_list<T,A,bW,W,bP,P> &
-  rollback_list<T,A,bW,W,bP,P>::operator=
-  (const rollback_list<T,A,bW,W,bP,P> &)
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline rollback_list<T,A,bW,W,bP,P,B> &
+  rollback_list<T,A,bW,W,bP,P,B>::operator=
+  (const rollback_list<T,A,bW,W,bP,P,B> &)
 {}
 
 // Destructor: iff there are nodes in the list (as a result of the
@@ -97,8 +98,8 @@ inline rollback_list<T,A,bW,W,bP,P> &
 // deallocate them. If the list is empty (the usual case), this
 // will take O(1). Otherwise, it will take O(n) time
 
-template<class T,class A,bool bW,class W,bool bP,class P>
-inline rollback_list<T,A,bW,W,bP,P>::~rollback_list ()
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
+inline rollback_list<T,A,bW,W,bP,P,B>::~rollback_list ()
 {
   node_t * p;
 
@@ -113,9 +114,9 @@ inline rollback_list<T,A,bW,W,bP,P>::~rollback_list ()
 // push_front(): insert a node at the beginning of the list. Time
 // required: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  rollback_list<T,A,bW,W,bP,P>::
+  rollback_list<T,A,bW,W,bP,P,B>::
   push_front (node_t * newnode)
 {
   newnode->m_next = m_first;
@@ -132,9 +133,9 @@ inline void
 // push_back(): append a node at the end of the list. Time
 // required: O(1)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  rollback_list<T,A,bW,W,bP,P>::
+  rollback_list<T,A,bW,W,bP,P,B>::
   push_back (node_t * newnode)
 {
   newnode->m_prev = m_last;
@@ -152,9 +153,9 @@ inline void
 // and last are received by reference). Reset the list (cancel
 // rollback)
 
-template<class T,class A,bool bW,class W,bool bP,class P>
+template<class T,class A,bool bW,class W,bool bP,class P,class B>
 inline void
-  rollback_list<T,A,bW,W,bP,P>::
+  rollback_list<T,A,bW,W,bP,P,B>::
   commit (node_t *& first,
           node_t *& last)
 {
@@ -0,0 +1,952 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/small_avl_array.hpp
+  --------------------------
+
+  Class small_avl_array: a sequence that keeps up to N elements
+  in an inline contiguous buffer (small mode), without any node
+  allocation nor tree overhead, and becomes an avl_array (tree
+  mode) when an insertion would exceed N elements. It goes back
+  to small mode when an erasure leaves L elements or less. The
+  buffer and the avl_array share the same storage (see
+  detail/small_buffer.hpp).
+
+  Iterator validity:
+
+  - Tree mode: like in avl_array, iterators are stable, unless
+    an erasure switches back to small mode
+  - Small mode: like in std::vector, insert() and erase()
+    invalidate the iterators at or after the position, and an
+    insertion in a full buffer switches to tree mode
+  - Switching mode invalidates every iterator and reference
+    (but insert() and erase() always return a valid one)
+
+  Methods:
+
+  Default con.: empty small_avl_array (O(1))
+  Copy con.: copy of other small_avl_array (O(N))
+  Destructor (O(N))
+  Assignment operator (O(M+N))
+  swap(): interchange contents (O(1) in tree mode, else O(M+N))
+  size(): number of elements (O(1))
+  empty(): true if size()==0 (O(1))
+  is_small(): true if the elements are in the inline buffer (O(1))
+  inline_capacity(): N (O(1))
+  begin(), end(), op.[], at(): (O(1) / O(log N) in tree mode)
+  front(), back(): (O(1))
+  insert(): insert one element (O(N) / O(log N) in tree mode)
+  erase(): erase one element (O(N) / O(log N) in tree mode)
+  push_front(), push_back(), pop_front(), pop_back(): idem
+  clear(): erase all (O(N))
+*/
+
+#ifndef _AVL_ARRAY_SMALL_AVL_ARRAY_HPP_
+#define _AVL_ARRAY_SMALL_AVL_ARRAY_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                       // Hybrid container class:
+         std::size_t N,                 // inline buffer of N
+         class A=std::allocator<T>,     // elements, or avl_array
+         std::size_t L=N/2>             // while size() > L
+class small_avl_array
+{
+  // -------------------------- TYPES ----------------------------
+
+  public:
+
+    typedef avl_array<T,A>                       avl_array_t;
+
+  private:
+
+    typedef small_avl_array<T,N,A,L>             my_class;
+    typedef small_storage<T,N,avl_array_t>       storage_t;
+
+    // There must be hysteresis (L<N); checked at compile time
+
+#ifdef AA_CXX11
+    static_assert (L<N, "small_avl_array requires L < N");
+#else
+    typedef char l_must_be_less_than_n [L<N ? 1 : -1];
+#endif
+
+  public:
+
+    typedef T                                    value_type;
+    typedef T &                                  reference;
+    typedef const T &                            const_reference;
+    typedef T *                                  pointer;
+    typedef const T *                            const_pointer;
+    typedef std::size_t                          size_type;
+    typedef std::ptrdiff_t                       difference_type;
+
+    typedef small_avl_array_iterator
+              <T,T&,T*,
+               typename avl_array_t::iterator>   iterator;
+    typedef small_avl_array_iterator
+              <T,const T&,const T*,
+               typename avl_array_t::const_iterator>
+                                                 const_iterator;
+
+
+  // ---------------------- PUBLIC INTERFACE ---------------------
+
+  public:
+
+    // Constructors and destructor
+    //
+    // Default con.: empty small_avl_array (O(1))
+    // Copy con.: copy of other small_avl_array (O(N))
+    // Destructor (O(N))
+
+    small_avl_array ();
+    small_avl_array (const my_class & a);
+    ~small_avl_array ();
+
+
+    // Container assignment and swap
+    //
+    // Assignment operator (O(M+N), M to delete + N to copy)
+    // swap(): interchange contents (O(1) if both are in tree
+    //         mode, O(M+N) otherwise)
+
+    const my_class & operator= (const my_class & a);
+    void swap (my_class & a);
+
+
+    // Size and mode
+    //
+    // size(): number of elements (O(1))
+    // empty(): true if size()==0 (O(1))
+    // is_small(): true if in small mode (O(1))
+    // inline_capacity(): N, maximum size in small mode (O(1))
+
+    size_type size () const;
+    bool empty () const;
+    bool is_small () const;
+    static size_type inline_capacity ();
+
+
+    // Iterators and element access
+    //
+    // begin(), end(): (O(1))
+    // op.[], at(): (O(1) in small mode, O(log N) in tree mode)
+    // front(), back(): (O(1))
+
+    iterator begin ();
+    iterator end ();
+    const_iterator begin () const;
+    const_iterator end () const;
+
+    reference operator[] (size_type n);
+    const_reference operator[] (size_type n) const;
+    reference at (size_type n);
+    const_reference at (size_type n) const;
+
+    reference front ();
+    reference back ();
+    const_reference front () const;
+    const_reference back () const;
+
+
+    // Insertion and erasure
+    //
+    // insert(): insert t before it (O(N) in small mode,
+    //           O(log N) in tree mode, O(N) when switching)
+    // erase(): erase the element at it (idem)
+    // push_front(), push_back(), pop_front(), pop_back(): idem
+    // clear(): erase all and go back to small mode (O(N))
+
+    iterator insert (iterator it, const_reference t);
+    iterator erase (iterator it);
+    void push_front (const_reference t);
+    void push_back (const_reference t);
+    void pop_front ();
+    void pop_back ();
+    void clear ();
+
+
+  // ------------------ PRIVATE HELPER METHODS -------------------
+
+  private:
+
+    T * buf ();                           // Inline buffer
+    const T * buf () const;               // (small mode)
+    avl_array_t & tree ();                // Embedded avl_array
+    const avl_array_t & tree () const;    // (tree mode)
+
+    template<class IT>
+    void fill_small (IT from, IT to);     // Copy into empty buffer
+    void copy_from (const my_class & a);  // Copy into empty *this
+    void destroy_small ();                // Destroy buffer elements
+    void detach (avl_array_t & t);        // Tree to t, small mode
+    void adopt (avl_array_t & t);         // t to tree, tree mode
+    void take (avl_array_t & t);          // t to buffer, or adopt
+    iterator grow (size_type i,           // Switch to tree mode
+                   const_reference t);    // inserting t at i
+    bool shrink ();                       // Switch to small mode
+
+
+  // ----------------------- DATA MEMBERS ------------------------
+
+  private:
+
+    storage_t m_storage;    // Buffer of N T's or an avl_array
+    size_type m_size;       // Elements in the buffer (small mode)
+    bool m_tree;            // Tree mode?
+};
+
+//////////////////////////////////////////////////////////////////
+
+// ---------------------- PUBLIC INTERFACE -----------------------
+
+// Default constructor: create an empty small_avl_array (in
+// small mode). The buffer is not touched.
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  small_avl_array<T,N,A,L>::small_avl_array ()
+  : m_size(0), m_tree(false)
+{
+}
+
+// Copy constructor: create a small_avl_array with copies of
+// the elements of a. The mode depends on the size only (a
+// tree with N or less elements is copied in small mode).
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  small_avl_array<T,N,A,L>::small_avl_array
+  (const typename small_avl_array<T,N,A,L>::my_class & a)
+  : m_size(0), m_tree(false)
+{
+  copy_from (a);
+}
+
+// Destructor: destroy the elements, and the tree (if any)
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  small_avl_array<T,N,A,L>::~small_avl_array ()
+{
+  clear ();
+}
+
+// Assignment operator: replace the current contents with a
+// copy of the contents of a. The new contents are copied
+// before the old ones are destroyed (if both are in tree
+// mode, avl_array's assignment does it), so *this is not
+// modified if something throws. When the old contents are in
+// the buffer, the new ones are copied aside, into a tree, and
+// then to the buffer; if this last copy throws, *this just
+// keeps them in tree mode.
+//
+// Complexity: O(M+N) (linear time)
+// (where M is the number of T objects to delete, and N is
+// the number of T objects to copy)
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  const typename small_avl_array<T,N,A,L>::my_class &
+  small_avl_array<T,N,A,L>::operator=
+  (const typename small_avl_array<T,N,A,L>::my_class & a)
+{
+  avl_array_t tmp;
+
+  if (&a == this) return *this;
+
+  if (a.size () > N)                   // To tree mode
+  {
+    if (m_tree)
+      tree () = a.tree ();
+    else
+    {
+      avl_array_t copy(a.tree ());     // Might throw
+      destroy_small ();
+      adopt (copy);
+    }
+  }
+  else if (m_tree)                     // Tree to small mode
+  {
+    detach (tmp);
+
+    try
+    {
+      fill_small (a.begin (), a.end ());
+    }
+    catch (...)
+    {
+      adopt (tmp);                     // Restore the tree
+      throw;
+    }
+  }
+  else if (!m_size)                    // Empty buffer (left
+    fill_small (a.begin (), a.end ()); // empty if it throws)
+  else
+  {
+    avl_array_t copy(a.begin (), a.end ());  // Might throw
+    destroy_small ();
+    take (copy);
+  }
+
+  return *this;
+}
+
+// swap(): interchange the contents of two small_avl_array
+// objects. If both are in tree mode, the trees are swapped
+// in O(1) time, and iterators keep referring the same
+// elements (now in the other container). Otherwise, the
+// elements are copied, and every iterator is invalidated:
+// the tree (if any) is detached and kept aside while the
+// buffer is copied into the other container, or, with two
+// buffers, one of them is first copied aside into a tree.
+// If a copy throws, both containers keep their contents
+// (one of them might be in tree mode then), so no element
+// is ever lost.
+//
+// Complexity: O(1) or O(M+N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  void
+  small_avl_array<T,N,A,L>::swap
+  (typename small_avl_array<T,N,A,L>::my_class & a)
+{
+  avl_array_t tmp;
+  my_class * t, * s;      // Tree mode and small mode
+
+  if (&a == this) return;
+
+  if (m_tree && a.m_tree)
+    tree ().swap (a.tree ());
+  else if (m_tree || a.m_tree)
+  {
+    t = m_tree ? this : &a;
+    s = m_tree ? &a : this;
+
+    t->detach (tmp);
+
+    try
+    {
+      t->fill_small (s->buf (), s->buf () + s->m_size);
+    }
+    catch (...)
+    {
+      t->adopt (tmp);                  // Restore the tree
+      throw;
+    }
+
+    s->destroy_small ();               // Nothing throws
+    s->adopt (tmp);                    // from here
+  }
+  else
+  {
+    avl_array_t copy(a.buf (), a.buf () + a.m_size); // Aside
+
+    a.destroy_small ();
+
+    try
+    {
+      a.fill_small (buf (), buf () + m_size);
+    }
+    catch (...)
+    {
+      a.adopt (copy);                  // Restore a (as a tree)
+      throw;
+    }
+
+    destroy_small ();
+    take (copy);                       // Can't throw
+  }
+}
+
+// size(): return the number of elements
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::size_type
+  small_avl_array<T,N,A,L>::size () const
+{
+  return m_tree ? tree ().size () : m_size;
+}
+
+// empty(): return true if there are no elements
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  bool
+  small_avl_array<T,N,A,L>::empty () const
+{
+  return !size ();
+}
+
+// is_small(): return true if the elements are in the inline
+// buffer, or false if they are in the embedded avl_array
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  bool
+  small_avl_array<T,N,A,L>::is_small () const
+{
+  return !m_tree;
+}
+
+// inline_capacity(): return N, the maximum number of
+// elements in small mode
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline //static
+  typename small_avl_array<T,N,A,L>::size_type
+  small_avl_array<T,N,A,L>::inline_capacity ()
+{
+  return N;
+}
+
+// begin(), end(): return an iterator to the first element,
+// or to the position after the last one
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::iterator
+  small_avl_array<T,N,A,L>::begin ()
+{
+  return m_tree ? iterator(tree ().begin ()) : iterator(buf ());
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::iterator
+  small_avl_array<T,N,A,L>::end ()
+{
+  return m_tree ? iterator(tree ().end ())
+                : iterator(buf () + m_size);
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::const_iterator
+  small_avl_array<T,N,A,L>::begin () const
+{
+  return m_tree ? const_iterator(tree ().begin ())
+                : const_iterator(buf ());
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::const_iterator
+  small_avl_array<T,N,A,L>::end () const
+{
+  return m_tree ? const_iterator(tree ().end ())
+                : const_iterator(buf () + m_size);
+}
+
+// Operator []: return (by reference) the n-th element
+//
+// Complexity: O(1) in small mode, O(log N) in tree mode
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::reference
+  small_avl_array<T,N,A,L>::operator[]
+  (typename small_avl_array<T,N,A,L>::size_type n)
+{
+  if (m_tree) return tree ()[n];
+  AA_ASSERT (n<m_size);
+  return buf ()[n];
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::const_reference
+  small_avl_array<T,N,A,L>::operator[]
+  (typename small_avl_array<T,N,A,L>::size_type n) const
+{
+  if (m_tree) return tree ()[n];
+  AA_ASSERT (n<m_size);
+  return buf ()[n];
+}
+
+// at(): like operator [], but throw index_out_of_bounds if
+// n is not less than size()
+//
+// Complexity: O(1) in small mode, O(log N) in tree mode
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::reference
+  small_avl_array<T,N,A,L>::at
+  (typename small_avl_array<T,N,A,L>::size_type n)
+{
+  AA_ASSERT_EXC (n<size (), index_out_of_bounds());
+  return (*this)[n];
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::const_reference
+  small_avl_array<T,N,A,L>::at
+  (typename small_avl_array<T,N,A,L>::size_type n) const
+{
+  AA_ASSERT_EXC (n<size (), index_out_of_bounds());
+  return (*this)[n];
+}
+
+// front(), back(): return (by reference) the first or the
+// last element
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::reference
+  small_avl_array<T,N,A,L>::front ()
+{
+  return *begin ();
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::reference
+  small_avl_array<T,N,A,L>::back ()
+{
+  return *--end ();
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::const_reference
+  small_avl_array<T,N,A,L>::front () const
+{
+  return *begin ();
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::const_reference
+  small_avl_array<T,N,A,L>::back () const
+{
+  return *--end ();
+}
+
+// insert(): insert a copy of t before the position it, and
+// return an iterator referring the new element. In small
+// mode, the following elements are shifted; if the buffer
+// is full, the container switches to tree mode (and the
+// contents are not modified if something throws then).
+//
+// Complexity: O(N) in small mode, O(log N) in tree mode
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  typename small_avl_array<T,N,A,L>::iterator
+  small_avl_array<T,N,A,L>::insert
+  (typename small_avl_array<T,N,A,L>::iterator it,
+   typename small_avl_array<T,N,A,L>::const_reference t)
+{
+  size_type i;
+
+  if (m_tree)
+    return iterator(tree ().insert (it.m_it, t));
+
+  AA_ASSERT (it.m_p);                    // it must point somewhere
+  i = it.m_p - buf ();
+  AA_ASSERT (i<=m_size);                 // it must point here
+
+  if (m_size==N)
+    return grow (i, t);                  // Full: switch mode
+
+  if (i==m_size)
+  {
+    new (buf () + m_size) T(t);          // Append
+    m_size ++;
+    return iterator(buf () + i);
+  }
+  else
+  {
+    T copy(t);                           // (t might be in buf)
+
+    new (buf () + m_size) T(buf ()[m_size-1]);
+    m_size ++;
+#ifdef AA_CXX11
+    std::move_backward (buf () + i, buf () + m_size - 2,
+                        buf () + m_size - 1);
+    buf ()[i] = std::move (copy);
+#else
+    std::copy_backward (buf () + i, buf () + m_size - 2,
+                        buf () + m_size - 1);
+    buf ()[i] = copy;
+#endif
+    return iterator(buf () + i);
+  }
+}
+
+// erase(): erase the element referred by it, and return an
+// iterator referring the next one. If this leaves L or less
+// elements in tree mode, the container switches to small
+// mode (unless a T copy constructor throws; then, it just
+// stays in tree mode).
+//
+// Complexity: O(N) in small mode, O(log N) in tree mode
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  typename small_avl_array<T,N,A,L>::iterator
+  small_avl_array<T,N,A,L>::erase
+  (typename small_avl_array<T,N,A,L>::iterator it)
+{
+  typename avl_array_t::iterator r;
+  size_type i;
+
+  if (m_tree)
+  {
+    r = tree ().erase (it.m_it);
+
+    if (tree ().size () > L)
+      return iterator(r);
+
+    i = r - tree ().begin ();
+    return shrink () ? iterator(buf () + i)
+                     : iterator(tree ().begin () + i);
+  }
+
+  AA_ASSERT (it.m_p);                    // it must point somewhere
+  i = it.m_p - buf ();
+  AA_ASSERT_EXC (i<m_size, invalid_op_with_end());
+
+#ifdef AA_CXX11
+  std::move (buf () + i + 1, buf () + m_size, buf () + i);
+#else
+  std::copy (buf () + i + 1, buf () + m_size, buf () + i);
+#endif
+  buf ()[--m_size].~T();
+  return iterator(buf () + i);
+}
+
+// push_front(), push_back(): insert a copy of t at the
+// beginning or at the end
+//
+// Complexity: see insert()
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::push_front
+  (typename small_avl_array<T,N,A,L>::const_reference t)
+{
+  insert (begin (), t);
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::push_back
+  (typename small_avl_array<T,N,A,L>::const_reference t)
+{
+  insert (end (), t);
+}
+
+// pop_front(), pop_back(): erase the first or the last
+// element
+//
+// Complexity: see erase()
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::pop_front ()
+{
+  erase (begin ());
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::pop_back ()
+{
+  AA_ASSERT_EXC (!empty (), invalid_op_with_end());
+  erase (--end ());
+}
+
+// clear(): erase every element, and go back to small mode
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  void
+  small_avl_array<T,N,A,L>::clear ()
+{
+  if (m_tree)
+  {
+    tree ().~avl_array_t ();
+    m_tree = false;
+  }
+  else
+    destroy_small ();
+}
+
+//////////////////////////////////////////////////////////////////
+
+// ------------------- PRIVATE HELPER METHODS --------------------
+
+// buf(), tree(): the storage seen as the inline buffer (small
+// mode) or as the embedded avl_array (tree mode)
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  T *
+  small_avl_array<T,N,A,L>::buf ()
+{
+  return reinterpret_cast<T*>(m_storage.m_bytes);
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  const T *
+  small_avl_array<T,N,A,L>::buf () const
+{
+  return reinterpret_cast<const T*>(m_storage.m_bytes);
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  typename small_avl_array<T,N,A,L>::avl_array_t &
+  small_avl_array<T,N,A,L>::tree ()
+{
+  AA_ASSERT (m_tree);
+  return *reinterpret_cast<avl_array_t*>(m_storage.m_bytes);
+}
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  const typename small_avl_array<T,N,A,L>::avl_array_t &
+  small_avl_array<T,N,A,L>::tree () const
+{
+  AA_ASSERT (m_tree);
+  return *reinterpret_cast<const avl_array_t*>(m_storage.m_bytes);
+}
+
+// fill_small(): copy the elements of [from,to) (N or less)
+// into the empty buffer of a container in small mode. If a
+// T copy constructor throws, the buffer is left empty.
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+template<class IT>
+//not inline
+  void
+  small_avl_array<T,N,A,L>::fill_small (IT from, IT to)
+{
+  AA_ASSERT (!m_tree && !m_size);
+
+  try
+  {
+    for (; from!=to; ++from)
+    {
+      AA_ASSERT (m_size<N);
+      new (buf () + m_size) T(*from);
+      m_size ++;
+    }
+  }
+  catch (...)
+  {
+    destroy_small ();
+    throw;
+  }
+}
+
+// copy_from(): copy the contents of a into *this, which must
+// be empty and in small mode. The mode depends on a.size().
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::copy_from
+  (const typename small_avl_array<T,N,A,L>::my_class & a)
+{
+  if (a.size () <= N)
+    fill_small (a.begin (), a.end ());
+  else
+  {
+    new (m_storage.m_bytes) avl_array_t(a.tree ());
+    m_tree = true;
+  }
+}
+
+// destroy_small(): destroy the elements in the buffer
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::destroy_small ()
+{
+  AA_ASSERT (!m_tree);
+
+  while (m_size)
+    buf ()[--m_size].~T();
+}
+
+// detach(): switch from tree mode to small mode (with an
+// empty buffer), giving the nodes of the tree to t, which
+// must be empty
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::detach
+  (typename small_avl_array<T,N,A,L>::avl_array_t & t)
+{
+  AA_ASSERT (m_tree && t.empty ());
+
+  t.swap (tree ());
+  tree ().~avl_array_t ();
+  m_tree = false;
+  m_size = 0;
+}
+
+// adopt(): switch from small mode (with an empty buffer) to
+// tree mode, taking the nodes of t (left empty)
+//
+// Complexity: O(1)
+
+template<class T,std::size_t N,class A,std::size_t L>
+inline
+  void
+  small_avl_array<T,N,A,L>::adopt
+  (typename small_avl_array<T,N,A,L>::avl_array_t & t)
+{
+  AA_ASSERT (!m_tree && !m_size);
+
+  new (m_storage.m_bytes) avl_array_t;
+  m_tree = true;
+  tree ().swap (t);
+}
+
+// take(): put the elements of t into *this, which must be in
+// small mode with an empty buffer. They are copied into the
+// buffer if they fit, or else (or if a copy throws) the
+// nodes of t are adopted. It never throws.
+//
+// Complexity: O(N), or O(1) if adopted
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  void
+  small_avl_array<T,N,A,L>::take
+  (typename small_avl_array<T,N,A,L>::avl_array_t & t)
+{
+  AA_ASSERT (!m_tree && !m_size);
+
+  if (t.size () <= N)
+  {
+    try
+    {
+      fill_small (t.begin (), t.end ());
+      return;
+    }
+    catch (...)
+    {
+    }                    // (buffer left empty)
+  }
+
+  adopt (t);
+}
+
+// grow(): switch from small mode (with a full buffer) to
+// tree mode, inserting a copy of t at the position i. The
+// tree is built aside first, so the contents are not
+// modified if something throws.
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  typename small_avl_array<T,N,A,L>::iterator
+  small_avl_array<T,N,A,L>::grow
+  (typename small_avl_array<T,N,A,L>::size_type i,
+   typename small_avl_array<T,N,A,L>::const_reference t)
+{
+  typename avl_array_t::iterator r;
+
+  avl_array_t tmp(buf (), buf () + m_size);    // Might throw
+  r = tmp.insert (tmp.begin () + i, t);        // Might throw
+
+  destroy_small ();                            // Nothing throws
+  adopt (tmp);           // (the nodes, and r, go to the tree)
+  return iterator(r);
+}
+
+// shrink(): switch from tree mode (with N or less elements)
+// to small mode. The tree is detached first; if a T copy
+// constructor throws, it is restored, and false is returned.
+//
+// Complexity: O(N)
+
+template<class T,std::size_t N,class A,std::size_t L>
+//not inline
+  bool
+  small_avl_array<T,N,A,L>::shrink ()
+{
+  avl_array_t tmp;
+
+  AA_ASSERT (tree ().size () <= N);
+
+  detach (tmp);
+
+  try
+  {
+    fill_small (tmp.begin (), tmp.end ());
+  }
+  catch (...)
+  {
+    adopt (tmp);                               // Go back to
+    return false;                              // tree mode
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
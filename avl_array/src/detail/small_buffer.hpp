@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/small_buffer.hpp
+  -----------------------
+
+  Storage and iterators of small_avl_array (see
+  detail/small_avl_array.hpp). The same raw storage holds either
+  an inline buffer of up to N elements (small mode) or an
+  avl_array (tree mode), and the iterators hold either a plain
+  pointer or an avl_array iterator.
+
+  The user of the library doesn't need to know about these
+  classes. They are for private use only.
+
+  Available classes are:
+
+    union small_storage              (room for N T's or a tree)
+    class small_avl_array_iterator   (pointer or tree iterator)
+*/
+
+#ifndef _AVL_ARRAY_SMALL_BUFFER_HPP_
+#define _AVL_ARRAY_SMALL_BUFFER_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+template<class T, std::size_t N, class AA>  // Room for N objects
+union small_storage                         // of type T, or for
+{                                           // an avl_array AA
+#ifdef AA_CXX11
+  alignas(T) alignas(AA)
+  char m_bytes[sizeof(T)*N>sizeof(AA) ? sizeof(T)*N : sizeof(AA)];
+#else
+  char m_bytes[sizeof(T)*N>sizeof(AA) ? sizeof(T)*N : sizeof(AA)];
+  long double m_ld;           // Without alignas, align to the
+  double m_d;                 // strictest fundamental types
+  long m_l;
+  void * m_p;
+  void (* m_f) ();
+#endif
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                    // 2-in-1 trick: Ref, Ptr
+         class Ref, class Ptr,       // and TIT (the avl_array
+         class TIT>                  // iterator) are re-defined
+class small_avl_array_iterator       // for const_iterator
+{
+  template<class U, class R, class Q, class I>
+  friend class small_avl_array_iterator;
+
+  template<class U, std::size_t M, class B, std::size_t K>
+  friend class mkr::small_avl_array;
+
+  typedef small_avl_array_iterator<T,Ref,Ptr,TIT>  my_class;
+
+  public: // -------------- PUBLIC INTERFACE ----------------
+
+#ifdef AA_USE_RANDOM_ACCESS_TAG
+    typedef std::random_access_iterator_tag      iterator_category;
+#else
+    typedef std::bidirectional_iterator_tag      iterator_category;
+#endif
+
+    typedef T                                    value_type;
+    typedef Ref                                  reference;
+    typedef Ptr                                  pointer;
+    typedef std::ptrdiff_t                       difference_type;
+
+    // Constructors: all O(1)
+
+    small_avl_array_iterator ()                  // Singular
+      : m_p(NULL), m_it(), m_tree(false) {}
+
+    template<class R, class Q, class I>          // Copy, or from
+    small_avl_array_iterator                     // non-const to
+      (const small_avl_array_iterator<T,R,Q,I> & it)  // const
+      : m_p(it.m_p), m_it(it.m_it), m_tree(it.m_tree) {}
+
+    // Dereference: O(1)
+
+    reference operator* () const
+    { return m_tree ? *m_it : *m_p; }
+
+    pointer operator-> () const
+    { return &**this; }
+
+    // Indexing: O(1) in small mode, O(log N) in tree mode
+
+    reference operator[] (difference_type n) const
+    { return *(*this + n); }
+
+    // Iterating: O(1)
+
+    my_class & operator++ ()
+    { if (m_tree) ++m_it; else ++m_p; return *this; }
+
+    my_class & operator-- ()
+    { if (m_tree) --m_it; else --m_p; return *this; }
+
+    my_class operator++ (int)
+    { my_class r(*this); ++*this; return r; }
+
+    my_class operator-- (int)
+    { my_class r(*this); --*this; return r; }
+
+    // Jumping: O(1) in small mode, O(log N) in tree mode
+
+    my_class & operator+= (difference_type n)
+    { if (m_tree) m_it += n; else m_p += n; return *this; }
+
+    my_class & operator-= (difference_type n)
+    { return *this += -n; }
+
+    my_class operator+ (difference_type n) const
+    { my_class r(*this); return r += n; }
+
+    my_class operator- (difference_type n) const
+    { my_class r(*this); return r += -n; }
+
+    // Difference and comparisons (both iterators must refer
+    // the same container): O(1) in small mode, == and != are
+    // O(1) and the rest are O(log N) in tree mode
+
+    template<class R, class Q, class I>
+    difference_type operator-
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return m_tree ? m_it - it.m_it : m_p - it.m_p; }
+
+    template<class R, class Q, class I>
+    bool operator==
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return m_tree ? m_it == it.m_it : m_p == it.m_p; }
+
+    template<class R, class Q, class I>
+    bool operator!=
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return !(*this == it); }
+
+    template<class R, class Q, class I>
+    bool operator<
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return (*this - it) < 0; }
+
+    template<class R, class Q, class I>
+    bool operator>
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return (*this - it) > 0; }
+
+    template<class R, class Q, class I>
+    bool operator<=
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return !(*this > it); }
+
+    template<class R, class Q, class I>
+    bool operator>=
+      (const small_avl_array_iterator<T,R,Q,I> & it) const
+    { return !(*this < it); }
+
+  private: // ----- PRIVATE DATA MEMBERS AND CONSTRUCTORS ------
+
+    explicit small_avl_array_iterator (Ptr p)    // Small mode
+      : m_p(p), m_it(), m_tree(false) {}
+
+    explicit small_avl_array_iterator (TIT it)   // Tree mode
+      : m_p(NULL), m_it(it), m_tree(true) {}
+
+    Ptr m_p;       // Element in the inline buffer (small mode)
+    TIT m_it;      // Element in the tree (tree mode)
+    bool m_tree;   // Which one is used
+};
+
+template<class T, class Ref, class Ptr, class TIT>     // n + it
+inline small_avl_array_iterator<T,Ref,Ptr,TIT> operator+
+  (std::ptrdiff_t n,
+   const small_avl_array_iterator<T,Ref,Ptr,TIT> & it)
+{ return it + n; }
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,468 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/static_avl_array.hpp
+  ---------------------------
+
+  Class static_avl_array: an avl_array with a fixed capacity,
+  whose nodes are stored inline, in the container object
+  itself. The heap is never used, and every node allocation
+  or deallocation takes O(1) time (see detail/static_pool.hpp).
+  Apart from the capacity, it behaves like avl_array.
+
+  It is built on top of avl_array, as a private base, so that
+  no other container can get at the pool: the methods that
+  would share the nodes with another avl_array (move
+  construction and assignment, splice(), merge(), the
+  allocator), use the pool from several threads
+  (parallel_assign()), or forget nodes (arena mode) are not
+  available.
+
+  Methods (the rest are avl_array's ones):
+
+  Default con.: empty static_avl_array (O(1))
+  Copy con.: copy of other static_avl_array (O(N))
+  Vector def. con.: with n default-constructed elem. (O(N))
+  Vector con.: with n elements like t (O(N))
+  Sequence con.: with copies of [from,to) (O(N))
+  Assignment operator (O(M+N))
+  swap(): interchange contents, element by element (O(M+N))
+  ==, !=, <, >, <=, >=: compare contents (O(min{M,N}))
+  capacity(): maximum number of elements (O(1))
+  max_size(): same as capacity() (O(1))
+  full(): true if size()==capacity() (O(1))
+*/
+
+#ifndef _AVL_ARRAY_STATIC_AVL_ARRAY_HPP_
+#define _AVL_ARRAY_STATIC_AVL_ARRAY_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+template<class T,                       // Fixed capacity
+         std::size_t C,                 // container class
+         bool bW=false,
+         class W=std::size_t,
+         bool bP=false,
+         class P=std::size_t>
+class static_avl_array
+  : private static_pool_storage<avl_array_node<T,
+                                  static_allocator<T>,
+                                  bW,W,bP,P,
+                                  avl_balance>, C>,
+    private avl_array<T,static_allocator<T>,bW,W,bP,P>
+{
+  // -------------------------- TYPES ----------------------------
+
+  public:
+
+    typedef avl_array<T,static_allocator<T>,
+                      bW,W,bP,P>                 avl_array_t;
+
+  private:
+
+    typedef static_pool_storage<avl_array_node<T,
+                                  static_allocator<T>,
+                                  bW,W,bP,P,
+                                  avl_balance>, C> storage_t;
+    typedef static_avl_array<T,C,bW,W,bP,P>      my_class;
+
+  public:
+
+    typedef typename avl_array_t::value_type      value_type;
+    typedef typename avl_array_t::reference       reference;
+    typedef typename avl_array_t::const_reference const_reference;
+    typedef typename avl_array_t::pointer         pointer;
+    typedef typename avl_array_t::const_pointer   const_pointer;
+    typedef typename avl_array_t::size_type       size_type;
+    typedef typename avl_array_t::difference_type difference_type;
+
+    typedef typename avl_array_t::iterator        iterator;
+    typedef typename avl_array_t::const_iterator  const_iterator;
+    typedef typename avl_array_t::reverse_iterator
+                                                  reverse_iterator;
+    typedef typename avl_array_t::const_reverse_iterator
+                                            const_reverse_iterator;
+
+
+  // ---------------------- PUBLIC INTERFACE ---------------------
+
+  public:
+
+    // Constructors (the destructor is avl_array's one)
+    //
+    // Default con.: empty static_avl_array (O(1))
+    // Copy con.: copy of other static_avl_array (O(N))
+    // Vector def. con.: with n default-constructed elem. (O(N))
+    // Vector con.: with n elements like t (O(N))
+    // Sequence con.: with copies of [from,to) (O(N))
+
+    static_avl_array ();
+    static_avl_array (const my_class & a);
+    explicit static_avl_array (size_type n);
+    static_avl_array (size_type n, const_reference t);
+
+    template <class IT>
+    static_avl_array (IT from, IT to);
+
+
+    // Container assignment and swap
+    //
+    // Assignment operator (O(M+N), M to delete + N to copy)
+    // swap(): interchange contents, element by element (O(M+N))
+    // (swap(it/rit,it/rit) is avl_array's one)
+
+    const my_class & operator= (const my_class & a);
+    void swap (my_class & a);
+
+
+    // Container comparison operators (see avl_array's ones)
+
+    bool operator== (const my_class & a) const;
+    bool operator!= (const my_class & a) const;
+    bool operator< (const my_class & a) const;
+    bool operator> (const my_class & a) const;
+    bool operator<= (const my_class & a) const;
+    bool operator>= (const my_class & a) const;
+
+
+    // Capacity
+    //
+    // capacity(): maximum number of elements (O(1))
+    // max_size(): same as capacity() (O(1))
+    // full(): true if size()==capacity() (O(1))
+
+    static size_type capacity ();
+    static size_type max_size ();
+    bool full () const;
+
+
+    // Methods of avl_array that use only the pool of this
+    // container, and only from the calling thread
+
+    using avl_array_t::size;
+    using avl_array_t::empty;
+    using avl_array_t::resize;
+
+    using avl_array_t::begin;
+    using avl_array_t::end;
+    using avl_array_t::rbegin;
+    using avl_array_t::rend;
+
+    using avl_array_t::operator[];
+    using avl_array_t::operator();
+    using avl_array_t::at;
+    using avl_array_t::front;
+    using avl_array_t::back;
+
+    using avl_array_t::insert;
+    using avl_array_t::erase;
+    using avl_array_t::clear;
+    using avl_array_t::push_front;
+    using avl_array_t::push_back;
+    using avl_array_t::pop_front;
+    using avl_array_t::pop_back;
+
+    using avl_array_t::apply_batch;
+    using avl_array_t::begin_batch;
+    using avl_array_t::end_batch;
+    using avl_array_t::in_batch;
+
+    using avl_array_t::swap;           // swap(it,it)
+    using avl_array_t::move;
+    using avl_array_t::reverse;
+
+    using avl_array_t::binary_search;
+    using avl_array_t::insert_sorted;
+    using avl_array_t::sort;
+    using avl_array_t::stable_sort;
+    using avl_array_t::unique;
+    using avl_array_t::radix_sort;
+    using avl_array_t::nth_element;
+    using avl_array_t::partial_sort;
+    using avl_array_t::top_k;
+    using avl_array_t::erase_if;
+    using avl_array_t::remove_if;
+    using avl_array_t::partition;
+    using avl_array_t::stable_partition;
+
+    using avl_array_t::parallel_for_each;
+    using avl_array_t::parallel_reduce;
+    using avl_array_t::compact_memory;
+
+    using avl_array_t::npsv_update_sums;
+    using avl_array_t::npsv_width;
+    using avl_array_t::npsv_set_width;
+    using avl_array_t::npsv_pos_of;
+    using avl_array_t::npsv_at_pos;
+    using avl_array_t::npsv_insert;
+    using avl_array_t::npsv_sample;
+    using avl_array_t::for_each_overlapping;
+
+    using avl_array_t::save;
+    using avl_array_t::load;
+};
+
+//////////////////////////////////////////////////////////////////
+
+// Default constructor: create an empty static_avl_array.
+// The blocks for the nodes are not touched.
+//
+// Complexity: O(1)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline
+  static_avl_array<T,C,bW,W,bP,P>::static_avl_array ()
+  : storage_t(),
+    avl_array_t(static_allocator<T>(storage_t::pool ()))
+{
+}
+
+// Copy constructor: create a static_avl_array copying the
+// contents of a into its own nodes
+//
+// Complexity: O(N)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline
+  static_avl_array<T,C,bW,W,bP,P>::static_avl_array
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  : storage_t(),
+    avl_array_t(a, static_allocator<T>(storage_t::pool ()))
+{
+}
+
+// Vector (default) constructor: create a static_avl_array
+// with n default-constructed elements. If n is greater than
+// C, capacity_exceeded is thrown.
+//
+// Complexity: O(N)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline
+  static_avl_array<T,C,bW,W,bP,P>::static_avl_array
+  (typename static_avl_array<T,C,bW,W,bP,P>::size_type n)
+  : storage_t(),
+    avl_array_t(static_allocator<T>(storage_t::pool ()))
+{
+  avl_array_t::resize (n);
+}
+
+// Vector constructor: create a static_avl_array with n
+// copies of t. If n is greater than C, capacity_exceeded
+// is thrown.
+//
+// Complexity: O(N)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline
+  static_avl_array<T,C,bW,W,bP,P>::static_avl_array
+  (typename static_avl_array<T,C,bW,W,bP,P>::size_type n,
+   typename static_avl_array<T,C,bW,W,bP,P>::const_reference t)
+  : storage_t(),
+    avl_array_t(static_allocator<T>(storage_t::pool ()))
+{
+  avl_array_t::resize (n, t);
+}
+
+// Sequence constructor: create a static_avl_array with
+// copies of the elements in [from,to). If there are more
+// than C, capacity_exceeded is thrown. Like in avl_array,
+// two integers are taken as (n,t) (see insert()).
+//
+// Complexity: O(N)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+template<class IT>
+inline
+  static_avl_array<T,C,bW,W,bP,P>::static_avl_array
+  (IT from, IT to)
+  : storage_t(),
+    avl_array_t(static_allocator<T>(storage_t::pool ()))
+{
+  avl_array_t::insert (avl_array_t::end (), from, to);
+}
+
+// Assignment operator: replace the current contents with
+// a copy of the contents of a. If both fit in the pool at
+// the same time, avl_array's assignment is used, and *this
+// is not modified if something throws. Otherwise, the old
+// contents are destroyed first, and *this is left empty if
+// something throws.
+//
+// Complexity: O(M+N) (linear time)
+// (where M is the number of T objects to delete, and N is
+// the number of T objects to copy)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+//not inline
+  const typename static_avl_array<T,C,bW,W,bP,P>::my_class &
+  static_avl_array<T,C,bW,W,bP,P>::operator=
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+{
+  if (&a == this) return *this;
+
+  if (avl_array_t::size () + a.size () > C)
+    avl_array_t::clear ();             // Make room first
+
+  avl_array_t::operator= (a);
+  return *this;
+}
+
+// swap(): interchange the contents of two static_avl_array
+// objects. Every container keeps its own nodes (they live
+// in it), so the elements are swapped one by one, and the
+// remaining elements of the longest one are copied to the
+// other and erased. Like with std::array, iterators keep
+// referring the same position of the same container. If a
+// T copy constructor throws, both containers are left in
+// a valid, but unspecified, state.
+//
+// Complexity: O(M+N)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+//not inline
+  void
+  static_avl_array<T,C,bW,W,bP,P>::swap
+  (typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+{
+  my_class * s, * l;      // Shorter and longer
+  iterator i, j, k;
+  size_type n;
+
+  if (&a == this) return;
+
+  s = avl_array_t::size () < a.size () ? this : &a;
+  l = s==this ? &a : this;
+
+  for (i=s->begin(), j=l->begin(); i!=s->end(); ++i, ++j)
+  {
+    using std::swap;      // (ADL still applies)
+    swap (*i, *j);        // Swap common part
+
+    if (bW)
+    {
+      W w = s->npsv_width (i);                       // Swap
+      s->npsv_set_width (i, l->npsv_width (j), false); // widths
+      l->npsv_set_width (j, w, false);                 // too
+    }
+  }
+
+  n = s->size ();
+  s->insert (s->end (), j, l->end ());  // Copy the rest
+
+  if (bW)
+    for (i=s->begin()+n, k=j; k!=l->end(); ++i, ++k)
+      s->npsv_set_width (i, l->npsv_width (k), false);
+
+  l->erase (j, l->end ());
+
+  if (bW)
+  {
+    s->npsv_update_sums ();  // Widths were set in lazy mode
+    l->npsv_update_sums ();
+  }
+}
+
+// Comparison operators: compare the contents, like the ones
+// of avl_array (the other container is not an avl_array for
+// the outside, so they can't be used directly)
+//
+// Complexity: O(min{M,N})
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline bool
+  static_avl_array<T,C,bW,W,bP,P>::operator==
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  const
+{ return avl_array_t::operator== (a); }
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline bool
+  static_avl_array<T,C,bW,W,bP,P>::operator!=
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  const
+{ return avl_array_t::operator!= (a); }
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline bool
+  static_avl_array<T,C,bW,W,bP,P>::operator<
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  const
+{ return avl_array_t::operator< (a); }
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline bool
+  static_avl_array<T,C,bW,W,bP,P>::operator>
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  const
+{ return avl_array_t::operator> (a); }
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline bool
+  static_avl_array<T,C,bW,W,bP,P>::operator<=
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  const
+{ return avl_array_t::operator<= (a); }
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline bool
+  static_avl_array<T,C,bW,W,bP,P>::operator>=
+  (const typename static_avl_array<T,C,bW,W,bP,P>::my_class & a)
+  const
+{ return avl_array_t::operator>= (a); }
+
+// capacity(): maximum number of elements
+//
+// Complexity: O(1)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline //static
+  typename static_avl_array<T,C,bW,W,bP,P>::size_type
+  static_avl_array<T,C,bW,W,bP,P>::capacity ()
+{
+  return C;
+}
+
+// max_size(): maximum number of elements (the same as
+// capacity(), instead of avl_array's theoretical limit)
+//
+// Complexity: O(1)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline //static
+  typename static_avl_array<T,C,bW,W,bP,P>::size_type
+  static_avl_array<T,C,bW,W,bP,P>::max_size ()
+{
+  return C;
+}
+
+// full(): true if no more elements can be added
+//
+// Complexity: O(1)
+
+template<class T,std::size_t C,bool bW,class W,bool bP,class P>
+inline
+  bool
+  static_avl_array<T,C,bW,W,bP,P>::full () const
+{
+  return avl_array_t::size () == C;
+}
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/static_pool.hpp
+  ----------------------
+
+  Fixed capacity node pool, used by static_avl_array. The nodes
+  are stored inline (in the container object itself), and they
+  are served from a free list, so that no heap allocation is
+  ever done, and every allocation/deallocation takes O(1) time.
+
+  The user of the library doesn't need to know about these
+  classes. They are for private use only.
+
+  Available classes are:
+
+    class static_pool          (free list over a block array)
+    union static_pool_block    (room for one node, aligned)
+    class static_pool_storage  (the blocks and their pool)
+    class static_allocator     (allocator interface to a pool)
+*/
+
+#ifndef _AVL_ARRAY_STATIC_POOL_HPP_
+#define _AVL_ARRAY_STATIC_POOL_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+  namespace detail  // Private nested namespace mkr::detail
+  {
+
+//////////////////////////////////////////////////////////////////
+
+class static_pool                 // Free list of fixed size blocks
+{                                 // (it doesn't own the blocks)
+  public:
+
+    static_pool (void * blocks,
+                 std::size_t block_size,
+                 std::size_t capacity)
+      : m_blocks(static_cast<char*>(blocks)),
+        m_block_size(block_size),
+        m_capacity(capacity),
+        m_fresh(0),
+        m_free(NULL)
+    { }
+
+    void * allocate (std::size_t bytes)     // Take a block: first
+    {                                       // from the free list,
+      void * p;                             // then from the never
+                                            // used ones
+      AA_ASSERT (bytes<=m_block_size);
+
+      if (m_free)
+      {
+        p = m_free;
+        m_free = *static_cast<void**>(p);
+        return p;
+      }
+
+      AA_ASSERT_EXC (m_fresh<m_capacity, capacity_exceeded());
+
+      return m_blocks + m_block_size * m_fresh++;
+    }
+
+    void deallocate (void * p)              // Put a block in the
+    {                                       // free list
+      AA_ASSERT (p);
+      *static_cast<void**>(p) = m_free;
+      m_free = p;
+    }
+
+    std::size_t capacity () const { return m_capacity; }
+
+  private:
+
+    static_pool (const static_pool &);             // Not copyable
+    void operator= (const static_pool &);
+
+    char * m_blocks;              // First block
+    std::size_t m_block_size;     // Bytes per block
+    std::size_t m_capacity;       // Number of blocks
+    std::size_t m_fresh;          // Blocks [m_fresh,m_capacity)
+                                  // have never been used
+    void * m_free;                // Free list (linked through
+};                                // the blocks themselves)
+
+//////////////////////////////////////////////////////////////////
+
+template<class N>             // Room for a node of type N (or for
+union static_pool_block       // a free list link), with the
+{                             // alignment that N requires
+#ifdef AA_CXX11
+  alignas(N) char m_node[sizeof(N)];
+#else
+  char m_node[sizeof(N)];
+  long double m_ld;           // Without alignas, align to the
+  double m_d;                 // strictest fundamental types
+  long m_l;
+  void * m_p;
+  void (* m_f) ();
+#endif
+  void * m_next;
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class N, std::size_t C>   // C blocks for nodes of type
+class static_pool_storage          // N, and the pool that serves
+{                                  // them (a base class of
+  protected:                       // static_avl_array, so that
+                                   // it is built before the
+    static_pool_storage ()         // avl_array part)
+      : m_pool(m_blocks, sizeof(static_pool_block<N>), C)
+    { }
+
+    static_pool * pool () { return &m_pool; }
+
+  private:
+
+    static_pool_storage (const static_pool_storage &); // Never
+    void operator= (const static_pool_storage &);      // copied
+
+    static_pool_block<N> m_blocks[C];  // Not initialized: O(1)
+    static_pool m_pool;
+};
+
+//////////////////////////////////////////////////////////////////
+
+template<class T>           // Allocator serving one object at a
+class static_allocator      // time from a static_pool (or from
+{                           // no pool at all: capacity 0)
+  template<class U> friend class static_allocator;
+
+  public:
+
+    typedef T                   value_type;
+    typedef T *                 pointer;
+    typedef const T *           const_pointer;
+    typedef T &                 reference;
+    typedef const T &           const_reference;
+    typedef std::size_t         size_type;
+    typedef std::ptrdiff_t      difference_type;
+
+    template<class U> struct rebind
+    {
+      typedef static_allocator<U> other;
+    };
+
+    explicit static_allocator (static_pool * pool)
+      : m_pool(pool)
+    { }
+
+    template<class U>
+    static_allocator (const static_allocator<U> & a)
+      : m_pool(a.m_pool)
+    { }
+
+    pointer allocate (size_type n, const void * =NULL)
+    {
+      AA_ASSERT (n==1);     // Nodes are allocated one by one
+      AA_ASSERT_EXC (m_pool, capacity_exceeded());
+      return static_cast<pointer>(m_pool->allocate (sizeof(T)));
+    }
+
+    void deallocate (pointer p, size_type)
+    {
+      m_pool->deallocate (p);
+    }
+
+    size_type max_size () const
+    {
+      return m_pool ? m_pool->capacity () : 0;
+    }
+
+    // A copy of the container must not take nodes from the
+    // pool of the original, which lives (and dies) in the
+    // original
+
+    static_allocator select_on_container_copy_construction () const
+    {
+      return static_allocator(NULL);
+    }
+
+    template<class U>
+    bool operator== (const static_allocator<U> & a) const
+    {
+      return m_pool==a.m_pool;
+    }
+
+    template<class U>
+    bool operator!= (const static_allocator<U> & a) const
+    {
+      return m_pool!=a.m_pool;
+    }
+
+  private:
+
+    static_pool * m_pool;
+};
+
+//////////////////////////////////////////////////////////////////
+
+#ifndef AA_CXX11
+
+template<class T, class N>              // Without C++11 traits,
+class aa_alloc_traits<static_allocator<T>,N> // every allocator
+{                                       // is supposed to be equal,
+  public:                               // but two pools are not
+
+    typedef T                                      value_type;
+    typedef T &                                    reference;
+    typedef const T &                              const_reference;
+    typedef T *                                    pointer;
+    typedef const T *                              const_pointer;
+
+    typedef static_allocator<N>                    node_allocator;
+
+    enum
+    {
+      always_equal = false,
+      propagate_on_copy = false,        // The pool stays with its
+      propagate_on_move = false,        // container
+      propagate_on_swap = false
+    };
+
+    static node_allocator select_on_copy (const node_allocator & a)
+    {
+      return a.select_on_container_copy_construction ();
+    }
+};
+
+#endif
+
+//////////////////////////////////////////////////////////////////
+
+  }  // namespace detail
+
+}  // namespace mkr
+
+#endif
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////
+//                                                               //
+//  Copyright (c) 2006-2009, Universidad de Alcala               //
+//                                                               //
+//  See accompanying LICENSE.TXT                                 //
+//                                                               //
+///////////////////////////////////////////////////////////////////
+
+/*
+  detail/stream_codec.hpp
+  -----------------------
+
+  Class raw_codec: the default element codec of avl_array's
+  save() and load(). It writes and reads the bytes of every
+  object as they are in memory, so it only fits trivially
+  copyable types, and the data can only be read back by
+  programs with the same layout of T (same platform and
+  compiler settings).
+
+  Other types need a codec of their own: any class with
+  these two methods (the stream state reports errors):
+
+    void save (std::ostream & os, const T & t);
+    void load (std::istream & is, T & t);
+*/
+
+#ifndef _AVL_ARRAY_STREAM_CODEC_HPP_
+#define _AVL_ARRAY_STREAM_CODEC_HPP_
+
+#ifndef _AVL_ARRAY_HPP_
+#error "Don't include this file. Include avl_array.hpp instead."
+#endif
+
+namespace mkr  // Public namespace
+{
+
+//////////////////////////////////////////////////////////////////
+
+template<class T>                // Copy the bytes of T to/from
+class raw_codec                  // a stream
+{
+#ifdef AA_CXX11
+  static_assert (std::is_trivially_copyable<T>::value,
+                 "raw_codec requires a trivially copyable T");
+#endif
+
+  public:
+
+    void save (std::ostream & os, const T & t)
+    { os.write (reinterpret_cast<const char*>(&t), sizeof (T)); }
+
+    void load (std::istream & is, T & t)
+    { is.read (reinterpret_cast<char*>(&t), sizeof (T)); }
+};
+
+//////////////////////////////////////////////////////////////////
+
+}  // namespace mkr
+
+#endif